@@ -29,6 +29,53 @@
  */
 
 #include "Adafruit_CAP1188.h"
+#if CAP1188_BUS_TRACE
+#include "Adafruit_CAP1188_BusTrace.h"
+#endif
+#if CAP1188_LATENCY
+#include "Adafruit_CAP1188_Latency.h"
+#endif
+#if CAP1188_SAMPLE_RING
+#include "Adafruit_CAP1188_SampleRing.h"
+#endif
+#if CAP1188_STORED_CONFIG
+#include "Adafruit_CAP1188_Storage.h"
+#endif
+
+/*!
+ *    @brief  Writable configuration registers, as runs of consecutive
+ *            addresses in the order they are kept in the configuration image
+ */
+static const struct {
+  uint8_t reg; ///< First register of the run
+  uint8_t len; ///< Number of registers in the run
+} configRuns[] = {
+    {CAP1188_SENSITIVITY, 6}, // through Averaging and Sampling Config
+    {CAP1188_INTENABLE, 2},   // and Repeat Rate Enable
+    {CAP1188_MTBLK, 2},       // and Multiple Touch Pattern Config
+    {CAP1188_MTPATTERN, 1},
+    {CAP1188_RECALCFG, 10},   // through the thresholds and Noise Threshold
+    {CAP1188_STANDBYCHAN, 5}, // through Configuration 2
+    {CAP1188_LEDOUTTYPE, 4},  // through LED Output Control
+    {CAP1188_LEDTRANSITION, 1},
+    {CAP1188_LEDMIRROR, 1},
+    {CAP1188_LEDBEHAVIOR1, 2},  // and LED Behavior 2
+    {CAP1188_LEDPULSE1PER, 3},  // through Breathe Period
+    {CAP1188_LEDCFG, 1},
+    {CAP1188_LEDPULSE1DUTY, 6}, // through LED Off Delay
+};
+
+#define CAP1188_CONFIG_RUNS (sizeof(configRuns) / sizeof(configRuns[0]))
+
+/*!
+ *    @brief  Checks the Product ID, Manufacturer ID and Revision
+ *    @param  id
+ *            the three ID registers, read in one burst
+ *    @return True if they identify a CAP1188
+ */
+static bool isCAP1188(const uint8_t id[3]) {
+  return id[0] == 0x50 && id[1] == 0x5D && id[2] == 0x83;
+}
 
 /*!
  *    @brief  Instantiates a new CAP1188 class using hardware I2C
@@ -85,7 +132,9 @@ Adafruit_CAP1188::Adafruit_CAP1188(uint8_t clkpin, uint8_t misopin,
  *    @brief  Setups the i2c depending on selected mode (I2C / SPI, Software /
  * Hardware). Displays useful debug info, as well as allow multiple touches
  * (CAP1188_MTBLK), links leds to touches (CAP1188_LEDLINK), and increase the
- * cycle time value (CAP1188_STANDBYCFG)
+ * cycle time value (CAP1188_STANDBYCFG). After setWarmStart(), a sensor that
+ * is still configured is kept as it is. After setStorage(), a stored profile
+ * is applied in place of these settings.
  *    @param  i2caddr
  *            optional i2caddres (default to 0x29)
  *    @param  theWire
@@ -93,65 +142,591 @@ Adafruit_CAP1188::Adafruit_CAP1188(uint8_t clkpin, uint8_t misopin,
  *    @return True if initialization was successful, otherwise false.
  */
 boolean Adafruit_CAP1188::begin(uint8_t i2caddr, TwoWire *theWire) {
-  if (spi_dev) {
+  if (replaying()) {
+    // A replayed trace stands in for the bus
+  } else if (spi_dev) {
     // Hardware or Software SPI
     if (!spi_dev->begin())
       return false;
   } else {
     // I2C
+    delete i2c_dev;
     i2c_dev = new Adafruit_I2CDevice(i2caddr, theWire);
-    if (!i2c_dev->begin())
+    // A sensor held in reset only answers after the reset pulse
+    bool detect = _resetpin == -1;
+#if CAP1188_BUS_STATS
+    if (detect) {
+      countTransaction(1, 2); // address detection
+    }
+#endif
+    if (!i2c_dev->begin(detect))
       return false;
   }
 
+  _addrPtr = -1;
+  invalidateFrame();
   if (_resetpin != -1) {
     pinMode(_resetpin, OUTPUT);
     digitalWrite(_resetpin, LOW);
-    delay(100);
-    digitalWrite(_resetpin, HIGH);
-    delay(100);
-    digitalWrite(_resetpin, LOW);
-    delay(100);
   }
-
-  readRegister(CAP1188_PRODID);
+  // Give up on a missing or different device before the reset delays. With
+  // a reset pin the sensor may just have been released, and is read again
+  // after the pulse.
+  uint8_t id[3];
+  bool found = readRegisters(CAP1188_PRODID, id, 3) && isCAP1188(id);
+  if (!found && _resetpin == -1) {
+    return false;
+  }
 
   // Useful debugging info. Comment/uncomment as needed.
 
   // Serial.print("Product ID: 0x");
-  // Serial.println(readRegister(CAP1188_PRODID), HEX);
+  // Serial.println(id[0], HEX);
   // Serial.print("Manuf. ID: 0x");
-  // Serial.println(readRegister(CAP1188_MANUID), HEX);
+  // Serial.println(id[1], HEX);
   // Serial.print("Revision: 0x");
-  // Serial.println(readRegister(CAP1188_REV), HEX);
+  // Serial.println(id[2], HEX);
+
+  _warmStarted = found && _warmStart && configuredSinceReset();
+  if (_warmStarted) {
+#if CAP1188_STORED_CONFIG
+    // Only written if the sensor does not already run the stored profile
+    _storedConfig = _storage && loadConfig();
+#endif
+    _ledOutput = configValue(CAP1188_LEDOUTPUT);
+    _ledOutputDirty = false;
+    return true;
+  }
+  if (_resetpin != -1) {
+    delay(100);
+    digitalWrite(_resetpin, HIGH);
+    delay(100);
+    digitalWrite(_resetpin, LOW);
+    delay(100);
+    if (!found && (!readRegisters(CAP1188_PRODID, id, 3) || !isCAP1188(id))) {
+      return false;
+    }
+  }
+
+#if CAP1188_STORED_CONFIG
+  // A stored profile replaces the whole configuration
+  _storedConfig = _storage && readProfile(_config);
+  if (_storedConfig) {
+    if (!restoreConfig()) {
+      return false;
+    }
+    _ledOutput = configValue(CAP1188_LEDOUTPUT);
+    _ledOutputDirty = false;
+    return true;
+  }
+#endif
 
-  if ((readRegister(CAP1188_PRODID) != 0x50) ||
-      (readRegister(CAP1188_MANUID) != 0x5D) ||
-      (readRegister(CAP1188_REV) != 0x83)) {
+  // Without a reset the sensor may have been left configured
+  if (!readConfig(_config)) {
     return false;
   }
   // allow multiple touches
   writeRegister(CAP1188_MTBLK, 0);
   // Have LEDs follow touches
   writeRegister(CAP1188_LEDLINK, 0xFF);
-  // speed up a bit
+  // speed up a bit, this also sets the sentinel checked by checkHealth()
   writeRegister(CAP1188_STANDBYCFG, 0x30);
+  _ledOutput = configValue(CAP1188_LEDOUTPUT);
+  _ledOutputDirty = false;
   return true;
 }
 
 /*!
- *   @brief  Reads the touched status (CAP1188_SENINPUTSTATUS)
+ *   @brief  Lets begin() keep a sensor that is still configured, e.g. after
+ *           only the microcontroller rebooted. begin() then skips the reset
+ *           pulse and the writes, and reads back the configuration in place
+ *           of writing it, so that the sensor keeps sensing without
+ *           recalibrating. Check warmStarted() to skip the sketch's own setup.
+ *           Call before begin().
+ *   @param  enable
+ *           true to keep a configured sensor, false (default) to always
+ *           reset it
+ */
+void Adafruit_CAP1188::setWarmStart(bool enable) { _warmStart = enable; }
+
+/*!
+ *   @brief  Checks whether the sensor has been set up by begin() since its
+ *           last reset, and loads its configuration if so
+ *   @return True if Standby Configuration is off its power-on default
+ */
+bool Adafruit_CAP1188::configuredSinceReset() {
+  return readConfig(_config) &&
+         configValue(CAP1188_STANDBYCFG) != CAP1188_STANDBYCFG_DEFAULT;
+}
+
+/*!
+ *   @brief  Finds the CAP1188s on an I2C bus, e.g. to skip unpopulated
+ *           accessory boards. Each address costs one address-only
+ *           transaction, plus an ID read if a device answers. Call before
+ *           begin().
+ *   @param  theWire
+ *           optional wire object
+ *   @return Found sensors, bit 0 set for CAP1188_I2CADDR_MIN up to bit 4
+ *           for CAP1188_I2CADDR_MAX
+ */
+uint8_t Adafruit_CAP1188::probe(TwoWire *theWire) {
+  uint8_t found = 0;
+  for (uint8_t addr = CAP1188_I2CADDR_MIN; addr <= CAP1188_I2CADDR_MAX;
+       addr++) {
+    Adafruit_I2CDevice dev(addr, theWire);
+    uint8_t reg = CAP1188_PRODID;
+    uint8_t id[3];
+    // Other parts share some of these addresses
+    if (dev.begin() && dev.write_then_read(&reg, 1, id, 3) && isCAP1188(id)) {
+      found |= 1 << (addr - CAP1188_I2CADDR_MIN);
+    }
+  }
+  return found;
+}
+
+/*!
+ *   @brief  Reads the touched status (CAP1188_SENINPUTSTATUS). Once
+ *           setInterruptPolicy() has been called, the status is only read
+ *           when the interrupt is set, and not at all while the ALERT pin
+ *           set with setAlertPin() is inactive.
  *   @return Returns read from CAP1188_SENINPUTSTATUS where 1 is touched, 0 not
- * touched.
+ * touched. Disabled inputs always read as not touched.
  */
 uint8_t Adafruit_CAP1188::touched() {
-  uint8_t t = readRegister(CAP1188_SENINPUTSTATUS);
-  if (t) {
-    writeRegister(CAP1188_MAIN, readRegister(CAP1188_MAIN) & ~CAP1188_MAIN_INT);
+#if CAP1188_FRAME_CACHE
+  if (_frameCache && frameFresh()) {
+    return _frameTouched;
   }
+#endif
+#if CAP1188_LATENCY
+  uint32_t readStart = _latency ? micros() : 0;
+#endif
+#if CAP1188_HEALTH_CHECK
+  pollHealth();
+#endif
+  uint8_t t;
+  if (_intDriven) {
+    // Without release interrupts a held input must be polled for release
+    bool poll = _touchState && !_intOnRelease;
+    // ALERT is active low
+    if (!poll && _alertPin >= 0 && digitalRead(_alertPin) == HIGH) {
+      t = _touchState;
+    } else {
+      uint8_t main = readRegister(CAP1188_MAIN);
+      // Clearing INT drops the latched status of released inputs, and is
+      // the only way to see a release that raises no interrupt
+      if ((main & CAP1188_MAIN_INT) || poll) {
+        writeRegister(CAP1188_MAIN, main & ~CAP1188_MAIN_INT);
+        poll = true;
+      }
+      if (poll) {
+        _touchState = readInputStatus() & getInputEnable();
+      }
+      t = _touchState;
+    }
+  } else {
+    t = readInputStatus();
+    if (t) {
+      writeRegister(CAP1188_MAIN,
+                    readRegister(CAP1188_MAIN) & ~CAP1188_MAIN_INT);
+    }
+    t &= getInputEnable();
+  }
+#if CAP1188_SAMPLE_RING
+  if (_ring) {
+    recordSample(0, t);
+  }
+#endif
+#if CAP1188_FRAME_CACHE
+  if (_frameCache) {
+    storeFrame(t);
+  }
+#endif
+#if CAP1188_LATENCY
+  if (_latency) {
+    recordLatency(t, readStart);
+  }
+#endif
   return t;
 }
 
+/*!
+ *   @brief  Reads Sensor Input Status for touched(). With
+ *           CAP1188_NOISE_EVENTS the same burst reads on to Noise Flag Status
+ *           and counts its rising edges.
+ *   @return Sensor Input Status, 0 if the read failed
+ */
+uint8_t Adafruit_CAP1188::readInputStatus() {
+#if CAP1188_NOISE_EVENTS
+  // Sensor Input Status through Noise Flag Status
+  uint8_t regs[CAP1188_NOISEFLAG - CAP1188_SENINPUTSTATUS + 1];
+  if (!readRegisters(CAP1188_SENINPUTSTATUS, regs, sizeof(regs))) {
+    return 0;
+  }
+  countNoise(regs[CAP1188_NOISEFLAG - CAP1188_SENINPUTSTATUS] &
+             getInputEnable());
+  return regs[0];
+#else
+  return readRegister(CAP1188_SENINPUTSTATUS);
+#endif
+}
+
+#if CAP1188_FRAME_CACHE
+/*!
+ *   @brief  Lets touched() return its last result again until the sensor
+ *           can have finished a new sensing cycle, see cycleTime(), or the
+ *           ALERT pin set with setAlertPin() is newly asserted. Any number of
+ *           touched() calls in a loop then cost one read per cycle. Requires
+ *           CAP1188_FRAME_CACHE, see Adafruit_CAP1188_Config.h.
+ *   @param  enable
+ *           true to reuse results, false (default) to read on every call
+ */
+void Adafruit_CAP1188::setFrameCache(bool enable) {
+  _frameCache = enable;
+  _frameValid = false;
+}
+
+/*!
+ *   @brief  Makes the next touched() call read the sensor, e.g. after
+ *           changing its configuration
+ */
+void Adafruit_CAP1188::invalidateFrame() { _frameValid = false; }
+
+/*!
+ *   @brief  Checks whether the cached touched() result is still current
+ *   @return True if no cycle has completed and ALERT has not been asserted
+ *           since the result was read
+ */
+bool Adafruit_CAP1188::frameFresh() {
+  bool edge = false;
+  if (_alertPin >= 0) {
+    // ALERT is active low
+    bool low = digitalRead(_alertPin) == LOW;
+    edge = low && !_alertLow;
+    _alertLow = low;
+  }
+  return _frameValid && !edge &&
+         (uint32_t)(micros() - _frameTime) < _framePeriod;
+}
+
+/*!
+ *   @brief  Keeps a freshly read touch status for touched() to reuse
+ *   @param  touched
+ *           Sensor Input Status, masked with the enabled inputs
+ */
+void Adafruit_CAP1188::storeFrame(uint8_t touched) {
+  _frameTouched = touched;
+  _frameTime = micros();
+  _framePeriod = cycleTime();
+  _frameValid = true;
+}
+#endif
+
+/*!
+ *   @brief  Selects the touch events that assert the interrupt, and switches
+ *           touched() to reading the status only when the interrupt is set.
+ *           With CAP1188_INT_PRESS_RELEASE a held input costs a single byte
+ *           read per touched() call, or nothing with an ALERT pin, and its
+ *           release is still reported within one sensing cycle. With
+ *           CAP1188_INT_PRESS a held input is polled, clearing the interrupt
+ *           on each touched() call, until it is released.
+ *   @param  policy
+ *           events that assert the interrupt
+ *   @return True if the writes succeeded
+ */
+bool Adafruit_CAP1188::setInterruptPolicy(cap1188_int_policy_t policy) {
+  uint8_t repeat = policy == CAP1188_INT_PRESS_REPEAT_RELEASE ? 0xFF : 0x00;
+  uint8_t config2 = configValue(CAP1188_CONFIG2) & ~CAP1188_CONFIG2_INT_REL_N;
+  if (policy == CAP1188_INT_PRESS) {
+    config2 |= CAP1188_CONFIG2_INT_REL_N;
+  }
+  if (!writeRegisters(CAP1188_REPEATEN, &repeat, 1) ||
+      !writeRegisters(CAP1188_CONFIG2, &config2, 1)) {
+    return false;
+  }
+  _intOnRelease = policy != CAP1188_INT_PRESS;
+  if (!_intDriven) {
+    _intDriven = true;
+    _touchState = readRegister(CAP1188_SENINPUTSTATUS) & getInputEnable();
+  }
+  return true;
+}
+
+/*!
+ *   @brief  Tells touched() which input the ALERT pin is connected to, so
+ *           that it can skip the bus entirely while no interrupt is pending.
+ *           Only used after setInterruptPolicy().
+ *   @param  pin
+ *           input pin, or -1 if ALERT is not connected
+ */
+void Adafruit_CAP1188::setAlertPin(int8_t pin) {
+  _alertPin = pin;
+  if (pin >= 0) {
+    pinMode(pin, INPUT_PULLUP);
+  }
+}
+
+/*!
+ *   @brief  Reads the touch, noise and general status in one burst and clears
+ *           the interrupt if it is set. Costs no more bus transactions than
+ *           touched() and counts noise events as touched() does. After
+ *           setInterruptPolicy(), the touch status is read again once the
+ *           interrupt is cleared, as touched() does, so that a release shows
+ *           in the read that clears its interrupt. With CAP1188_INT_PRESS the
+ *           interrupt is also cleared while an input is held.
+ *   @param  snapshot
+ *           filled with the captured status
+ *   @return True if the read succeeded
+ */
+bool Adafruit_CAP1188::readSnapshot(cap1188_snapshot_t *snapshot) {
+#if CAP1188_LATENCY
+  uint32_t readStart = _latency ? micros() : 0;
+#endif
+#if CAP1188_HEALTH_CHECK
+  pollHealth();
+#endif
+  // Main Control through Noise Flag Status
+  uint8_t regs[CAP1188_NOISEFLAG + 1];
+  if (!readRegisters(CAP1188_MAIN, regs, sizeof(regs))) {
+    return false;
+  }
+  snapshot->touched = regs[CAP1188_SENINPUTSTATUS] & getInputEnable();
+  snapshot->noise = regs[CAP1188_NOISEFLAG] & getInputEnable();
+  snapshot->status = regs[CAP1188_GENSTATUS];
+  snapshot->calibrating = _calPending;
+#if CAP1188_NOISE_EVENTS
+  countNoise(snapshot->noise);
+#endif
+  // Without release interrupts a held input must be polled for release, as
+  // in touched()
+  bool poll = _intDriven && _touchState && !_intOnRelease;
+  if ((regs[CAP1188_MAIN] & CAP1188_MAIN_INT) || poll) {
+    writeRegister(CAP1188_MAIN, regs[CAP1188_MAIN] & ~CAP1188_MAIN_INT);
+    if (_intDriven) {
+      // Clearing INT drops the latched status of released inputs, so the
+      // burst still shows them touched
+      snapshot->touched =
+          readRegister(CAP1188_SENINPUTSTATUS) & getInputEnable();
+    }
+  }
+  _touchState = snapshot->touched;
+#if CAP1188_FRAME_CACHE
+  if (_frameCache) {
+    storeFrame(snapshot->touched);
+  }
+#endif
+#if CAP1188_SAMPLE_RING
+  if (_ring) {
+    recordSample(snapshot->status, snapshot->touched);
+  }
+#endif
+#if CAP1188_LATENCY
+  if (_latency) {
+    recordLatency(snapshot->touched, readStart);
+  }
+#endif
+  return true;
+}
+
+#if CAP1188_LATENCY
+#ifndef IRAM_ATTR
+#define IRAM_ATTR ///< Places interrupt handlers in IRAM on ESP cores
+#endif
+
+/*!
+ *   @brief  Has touched() and readSnapshot() add the latency of every touch
+ *           status change they return to a histogram. A latency runs from
+ *           the ALERT edge passed to alertEdge(), or without one from the
+ *           start of the read that first saw the change. Requires
+ *           CAP1188_LATENCY, see Adafruit_CAP1188_Config.h.
+ *   @param  histogram
+ *           histogram to fill, or NULL to stop measuring
+ */
+void Adafruit_CAP1188::setLatencyHistogram(
+    Adafruit_CAP1188_Latency *histogram) {
+  _edgePending = false;
+  _latency = histogram;
+}
+
+/*!
+ *   @brief  Timestamps an ALERT edge as the start of the next latency. Call
+ *           it from an interrupt handler attached to the falling edge of the
+ *           ALERT pin, declared IRAM_ATTR on ESP cores; without one,
+ *           latencies start at the read that first sees a change.
+ */
+void IRAM_ATTR Adafruit_CAP1188::alertEdge() {
+  if (!_edgePending) {
+    _edgeTime = micros();
+    _edgePending = true;
+  }
+}
+
+/*!
+ *   @brief  Counts the latency of a touch status that differs from the one
+ *           returned before
+ *   @param  touched
+ *           touch status about to be returned
+ *   @param  readStart
+ *           micros() when the read of it began
+ */
+void Adafruit_CAP1188::recordLatency(uint8_t touched, uint32_t readStart) {
+  noInterrupts();
+  uint32_t edge = _edgeTime;
+  // An edge from before the read started is answered by it
+  bool answered = _edgePending && (int32_t)(edge - readStart) <= 0;
+  if (answered) {
+    _edgePending = false;
+  }
+  interrupts();
+  if (touched != _deliveredTouched) {
+    _deliveredTouched = touched;
+    _latency->add(micros() - (answered ? edge : readStart));
+  }
+}
+#endif
+
+#if CAP1188_SAMPLE_RING
+/*!
+ *   @brief  Has touched() and readSnapshot() append a timestamped sample to a
+ *           ring buffer on every call. If the ring stores delta counts, they
+ *           are read in one extra burst per sample. Requires
+ *           CAP1188_SAMPLE_RING, see Adafruit_CAP1188_Config.h.
+ *   @param  ring
+ *           ring to fill, or NULL to stop capturing
+ */
+void Adafruit_CAP1188::setSampleRing(Adafruit_CAP1188_SampleRing *ring) {
+  _ring = ring;
+}
+#endif
+
+#if CAP1188_BUS_TRACE
+/*!
+ *   @brief  Records every register transaction into a trace, or, if the
+ *           trace is replaying, takes the sensor's responses from it instead
+ *           of the bus. Attach a replaying trace before begin() to run the
+ *           driver without hardware. Such a begin() sets up no bus, so once
+ *           the trace is detached or records, register access fails until
+ *           begin() is called again. Requires CAP1188_BUS_TRACE, see
+ *           Adafruit_CAP1188_Config.h.
+ *   @param  trace
+ *           trace to record into or replay from, or NULL to detach
+ */
+void Adafruit_CAP1188::setBusTrace(Adafruit_CAP1188_BusTrace *trace) {
+  _trace = trace;
+}
+#endif
+
+#if CAP1188_BUS_STATS
+/*!
+ *   @brief  Gets the bus traffic generated since the last resetBusStats().
+ *           Requires CAP1188_BUS_STATS, see Adafruit_CAP1188_Config.h.
+ *   @param  stats
+ *           filled with the transaction, byte and bit counts
+ */
+void Adafruit_CAP1188::getBusStats(cap1188_bus_stats_t *stats) {
+  *stats = _stats;
+}
+
+/*!
+ *   @brief  Clears the bus traffic counters
+ */
+void Adafruit_CAP1188::resetBusStats() { memset(&_stats, 0, sizeof(_stats)); }
+
+/*!
+ *   @brief  Estimates the time the counted traffic occupies the wire
+ *   @param  stats
+ *           traffic, as from getBusStats()
+ *   @param  clock
+ *           bus clock in Hz, e.g. 100000 or 400000 for I2C
+ *   @return Wire time in microseconds, excluding gaps between transactions
+ */
+uint32_t Adafruit_CAP1188::wireTime(const cap1188_bus_stats_t *stats,
+                                    uint32_t clock) {
+  return (uint64_t)stats->bits * 1000000UL / clock;
+}
+
+/*!
+ *   @brief  Adds one transaction to the bus traffic counters
+ *   @param  bytes
+ *           bytes on the wire, including address and command bytes
+ *   @param  conditions
+ *           I2C start, repeated start and stop conditions
+ */
+void Adafruit_CAP1188::countTransaction(uint16_t bytes, uint8_t conditions) {
+  _stats.transactions++;
+  _stats.bytes += bytes;
+  // I2C bytes take an extra clock for the ACK
+  _stats.bits += (uint32_t)bytes * (spi_dev ? 8 : 9) + conditions;
+}
+#endif
+
+#if CAP1188_BUS_TRACE
+/*!
+ *   @brief  Checks whether a replaying trace stands in for the bus
+ *   @return True if register traffic is served from a trace
+ */
+bool Adafruit_CAP1188::replaying() { return _trace && _trace->replaying(); }
+#endif
+
+/*!
+ *   @brief  Checks that transactions can be made
+ *   @return True if a trace is being replayed or begin() set up a bus. A
+ *           begin() that ran against a replayed trace sets up none.
+ */
+bool Adafruit_CAP1188::hasBus() { return replaying() || i2c_dev || spi_dev; }
+
+#if CAP1188_SAMPLE_RING
+/*!
+ *   @brief  Appends a sample to the capture ring
+ *   @param  status
+ *           General Status, 0 if not read
+ *   @param  touched
+ *           Sensor Input Status
+ */
+void Adafruit_CAP1188::recordSample(uint8_t status, uint8_t touched) {
+  int8_t deltas[8];
+  bool haveDeltas = _ring->capturesDeltas() && readDeltas(deltas);
+  _ring->push(status, touched, haveDeltas ? deltas : NULL, micros());
+}
+#endif
+
+#if CAP1188_NOISE_EVENTS
+/*!
+ *   @brief  Gets the number of times an input's noise flag was seen to rise
+ *           by touched() or readSnapshot(), saturating at 65535. A flag that
+ *           stays set across reads counts once. Requires
+ *           CAP1188_NOISE_EVENTS, see Adafruit_CAP1188_Config.h.
+ *   @param  channel
+ *           input, 0-7
+ *   @return Noise event count
+ */
+uint16_t Adafruit_CAP1188::noiseEvents(uint8_t channel) {
+  return _noiseEvents[channel & 7];
+}
+
+/*!
+ *   @brief  Clears the per-input noise event counters
+ */
+void Adafruit_CAP1188::resetNoiseEvents() {
+  memset(_noiseEvents, 0, sizeof(_noiseEvents));
+}
+
+/*!
+ *   @brief  Counts the noise flags that have risen since the last read
+ *   @param  noise
+ *           Noise Flag Status, masked with the enabled inputs
+ */
+void Adafruit_CAP1188::countNoise(uint8_t noise) {
+  uint8_t rising = noise & ~_noiseFlags;
+  _noiseFlags = noise;
+  for (uint8_t i = 0; i < 8; i++) {
+    if ((rising & (1 << i)) && _noiseEvents[i] != 0xFFFF) {
+      _noiseEvents[i]++;
+    }
+  }
+}
+#endif
+
 /*!
  *   @brief  Controls the output polarity of LEDs.
  *   @param  inverted
@@ -162,23 +737,784 @@ void Adafruit_CAP1188::LEDpolarity(uint8_t inverted) {
   writeRegister(CAP1188_LEDPOL, inverted);
 }
 
+/*!
+ *   @brief  Sets the touch thresholds of all eight inputs in one block write
+ *   @param  thresholds
+ *           threshold for each input, 0-127 (power-on default 0x40)
+ *   @return True if the write succeeded
+ */
+bool Adafruit_CAP1188::setThresholds(const uint8_t thresholds[8]) {
+  uint8_t buffer[8];
+  for (uint8_t i = 0; i < 8; i++) {
+    buffer[i] = thresholds[i] & 0x7F;
+  }
+  // Input 1 is written first, so with BUT_LD_TH set its broadcast to the
+  // other inputs is overwritten by the values that follow
+  return writeRegisters(CAP1188_THRESH1, buffer, 8);
+}
+
+/*!
+ *   @brief  Reads back the touch thresholds of all eight inputs in one burst
+ *   @param  thresholds
+ *           filled with the threshold of each input
+ *   @return True if the read succeeded
+ */
+bool Adafruit_CAP1188::getThresholds(uint8_t thresholds[8]) {
+  return readRegisters(CAP1188_THRESH1, thresholds, 8);
+}
+
+/*!
+ *   @brief  Sets the noise threshold shared by all inputs
+ *   @param  noise
+ *           noise threshold as a percentage of the touch threshold
+ *   @return True if the write succeeded
+ */
+bool Adafruit_CAP1188::setNoiseThreshold(cap1188_noise_threshold_t noise) {
+  uint8_t value = noise & 0x03;
+  return writeRegisters(CAP1188_NOISETHRESH, &value, 1);
+}
+
+/*!
+ *   @brief  Reads the noise threshold shared by all inputs
+ *   @return The noise threshold as a percentage of the touch threshold
+ */
+cap1188_noise_threshold_t Adafruit_CAP1188::getNoiseThreshold() {
+  return (cap1188_noise_threshold_t)(readRegister(CAP1188_NOISETHRESH) & 0x03);
+}
+
+/*!
+ *   @brief  Sets the delta sensitivity and base count scaling
+ *   @param  sensitivity
+ *           touch detection sensitivity multiplier
+ *   @param  baseShift
+ *           base count data scaling, 0-15 (power-on default 0xF)
+ *   @return True if the write succeeded
+ */
+bool Adafruit_CAP1188::setSensitivity(cap1188_sensitivity_t sensitivity,
+                                      uint8_t baseShift) {
+  uint8_t value = ((sensitivity & 0x07) << 4) | (baseShift & 0x0F);
+  return writeRegisters(CAP1188_SENSITIVITY, &value, 1);
+}
+
+/*!
+ *   @brief  Reads the delta sensitivity
+ *   @return The touch detection sensitivity multiplier
+ */
+cap1188_sensitivity_t Adafruit_CAP1188::getSensitivity() {
+  return (cap1188_sensitivity_t)((readRegister(CAP1188_SENSITIVITY) >> 4) &
+                                 0x07);
+}
+
+/*!
+ *   @brief  Reads the base count data scaling
+ *   @return BASE_SHIFT, 0-15
+ */
+uint8_t Adafruit_CAP1188::getBaseShift() {
+  return readRegister(CAP1188_SENSITIVITY) & 0x0F;
+}
+
+/*!
+ *   @brief  Selects the inputs that are sampled. Every disabled input
+ *           shortens the sensing cycle, see cycleTime().
+ *   @param  mask
+ *           inputs to sample, bit 0 is input 1
+ *   @return True if the write succeeded
+ */
+bool Adafruit_CAP1188::setInputEnable(uint8_t mask) {
+  return writeRegisters(CAP1188_SENINPUTEN, &mask, 1);
+}
+
+/*!
+ *   @brief  Sets the averaging, sample time and programmed cycle time
+ *   @param  averaging
+ *           samples averaged per measurement
+ *   @param  sampleTime
+ *           time taken by a single sample
+ *   @param  cycleTime
+ *           programmed time between two sensing cycles
+ *   @return True if the write succeeded
+ */
+bool Adafruit_CAP1188::setSampling(cap1188_averaging_t averaging,
+                                   cap1188_sample_time_t sampleTime,
+                                   cap1188_cycle_time_t cycleTime) {
+  uint8_t value =
+      ((averaging & 0x07) << 4) | ((sampleTime & 0x03) << 2) | (cycleTime & 3);
+  return writeRegisters(CAP1188_AVGSAMPLE, &value, 1);
+}
+
+/*!
+ *   @brief  Computes the effective sensing cycle time. The programmed cycle
+ *           time is stretched when measuring all enabled inputs takes longer.
+ *   @return Cycle time in microseconds
+ */
+uint32_t Adafruit_CAP1188::cycleTime() {
+  uint32_t programmed = 35000UL * ((configValue(CAP1188_AVGSAMPLE) & 3) + 1);
+  uint8_t inputs = 0;
+  for (uint8_t m = getInputEnable(); m; m &= m - 1) {
+    inputs++;
+  }
+  uint32_t sensing = measureTime() * inputs;
+  return sensing > programmed ? sensing : programmed;
+}
+
+/*!
+ *   @brief  Computes the worst-case time from a touch to its status being
+ *           set: a touch that just misses its input's measurement waits a
+ *           full cycle plus that measurement.
+ *   @return Latency in microseconds
+ */
+uint32_t Adafruit_CAP1188::maxLatency() {
+  return cycleTime() + measureTime();
+}
+
+/*!
+ *   @brief  Computes the time taken to measure one input
+ *   @return Sample time times the number of samples averaged, in microseconds
+ */
+uint32_t Adafruit_CAP1188::measureTime() {
+  uint8_t avgSample = configValue(CAP1188_AVGSAMPLE);
+  return (320UL << ((avgSample >> 2) & 0x03)) << ((avgSample >> 4) & 0x07);
+}
+
+/*!
+ *   @brief  Starts calibration of the selected inputs. Completion can be
+ *           polled with calibrationDone() without blocking.
+ *   @param  channelMask
+ *           inputs to calibrate, bit 0 is input 1. Disabled inputs are
+ *           skipped.
+ *   @return True if the write succeeded
+ */
+bool Adafruit_CAP1188::calibrate(uint8_t channelMask) {
+  channelMask &= getInputEnable();
+  if (!writeRegisters(CAP1188_CALACTIVE, &channelMask, 1)) {
+    return false;
+  }
+  _calPending |= channelMask;
+  return true;
+}
+
+/*!
+ *   @brief  Checks whether the calibration started by calibrate() has
+ *           completed
+ *   @param  baseCounts
+ *           optional, filled with the base counts of all inputs in one burst
+ *           whenever no calibration is pending
+ *   @return True if no calibration is pending and the base counts, if
+ *           requested, were read
+ */
+bool Adafruit_CAP1188::calibrationDone(uint8_t baseCounts[8]) {
+  if (_calPending) {
+    _calPending &= readRegister(CAP1188_CALACTIVE);
+    if (_calPending) {
+      return false;
+    }
+  }
+  return !baseCounts || readBaseCounts(baseCounts);
+}
+
+/*!
+ *   @brief  Calibrates the selected inputs and waits for completion
+ *   @param  channelMask
+ *           inputs to calibrate, bit 0 is input 1
+ *   @param  timeout
+ *           maximum time to wait in milliseconds
+ *   @param  baseCounts
+ *           optional, filled with the base counts of all inputs once
+ *           calibration has completed
+ *   @return True if calibration completed before the timeout
+ */
+bool Adafruit_CAP1188::calibrateAndWait(uint8_t channelMask, uint16_t timeout,
+                                        uint8_t baseCounts[8]) {
+  if (!calibrate(channelMask)) {
+    return false;
+  }
+  uint32_t start = millis();
+  while (!calibrationDone(baseCounts)) {
+    if ((uint32_t)(millis() - start) > timeout) {
+      return false;
+    }
+    delay(5);
+  }
+  return true;
+}
+
+/*!
+ *   @brief  Configures automatic recalibration
+ *   @param  negDelta
+ *           consecutive negative delta readings that trigger recalibration
+ *   @param  config
+ *           recalibration averaging samples and update time
+ *   @param  thresholdLink
+ *           true (default) - writing the input 1 threshold updates all
+ *           thresholds
+ *   @param  clearIntermediate
+ *           true (default) - the intermediate data is cleared when a touch
+ *           is detected past the maximum duration
+ *   @param  clearNegative
+ *           true (default) - the negative delta counter is cleared when a
+ *           touch is detected
+ *   @return True if the write succeeded
+ */
+bool Adafruit_CAP1188::setRecalibration(cap1188_neg_delta_count_t negDelta,
+                                        cap1188_recal_config_t config,
+                                        bool thresholdLink,
+                                        bool clearIntermediate,
+                                        bool clearNegative) {
+  uint8_t value = ((negDelta & 0x03) << 3) | (config & 0x07);
+  if (thresholdLink)
+    value |= 0x80;
+  if (!clearIntermediate)
+    value |= 0x40;
+  if (!clearNegative)
+    value |= 0x20;
+  return writeRegisters(CAP1188_RECALCFG, &value, 1);
+}
+
+/*!
+ *   @brief  Reads the base counts of all eight inputs in one burst
+ *   @param  counts
+ *           filled with the base count of each input
+ *   @return True if the read succeeded
+ */
+bool Adafruit_CAP1188::readBaseCounts(uint8_t counts[8]) {
+  return readRegisters(CAP1188_BASECOUNT1, counts, 8);
+}
+
+/*!
+ *   @brief  Reads the delta counts of all eight inputs in one burst
+ *   @param  deltas
+ *           filled with the signed delta count of each input, capped at
+ *           +127 by the sensor
+ *   @return True if the read succeeded
+ */
+bool Adafruit_CAP1188::readDeltas(int8_t deltas[8]) {
+  return readRegisters(CAP1188_DELTA1, (uint8_t *)deltas, 8);
+}
+
+/*!
+ *   @brief  Has the sensor flag a specific combination of touched inputs in
+ *           hardware. A match sets CAP1188_GENSTATUS_MTP, seen in
+ *           readSnapshot(), and asserts the ALERT pin.
+ *   @param  pattern
+ *           inputs that form the chord, bit 0 is input 1
+ *   @param  threshold
+ *           fraction of the touch threshold an input must exceed to count
+ *   @return True if the writes succeeded
+ */
+bool Adafruit_CAP1188::setTouchPattern(uint8_t pattern,
+                                       cap1188_mtp_threshold_t threshold) {
+  // MTP_EN, COMP_PTRN and MTP_ALERT
+  uint8_t cfg = 0x80 | ((threshold & 0x03) << 2) | 0x02 | 0x01;
+  return writeRegisters(CAP1188_MTPATTERN, &pattern, 1) &&
+         writeRegisters(CAP1188_MTPCFG, &cfg, 1);
+}
+
+/*!
+ *   @brief  Has the sensor flag more than a number of simultaneously touched
+ *           inputs in hardware. Exceeding the limit sets
+ *           CAP1188_GENSTATUS_MTP, seen in readSnapshot(), and asserts the
+ *           ALERT pin.
+ *   @param  maxTouches
+ *           number of simultaneous touches allowed, 0-7
+ *   @param  threshold
+ *           fraction of the touch threshold an input must exceed to count
+ *   @return True if the writes succeeded
+ */
+bool Adafruit_CAP1188::setTouchLimit(uint8_t maxTouches,
+                                     cap1188_mtp_threshold_t threshold) {
+  if (maxTouches > 7) {
+    return false;
+  }
+  // Without COMP_PTRN only the number of bits set in the pattern matters
+  uint8_t pattern = (1 << (maxTouches + 1)) - 1;
+  uint8_t cfg = 0x80 | ((threshold & 0x03) << 2) | 0x01;
+  return writeRegisters(CAP1188_MTPATTERN, &pattern, 1) &&
+         writeRegisters(CAP1188_MTPCFG, &cfg, 1);
+}
+
+/*!
+ *   @brief  Disables multiple touch pattern detection
+ *   @return True if the write succeeded
+ */
+bool Adafruit_CAP1188::disableTouchPattern() {
+  uint8_t cfg = 0;
+  return writeRegisters(CAP1188_MTPCFG, &cfg, 1);
+}
+
+/*!
+ *   @brief  Selects the output type of each LED pin
+ *   @param  pushPullMask
+ *           a '1' selects push-pull, a '0' open-drain (default), bit 0 is
+ *           LED 1
+ *   @return True if the write succeeded
+ */
+bool Adafruit_CAP1188::setLEDOutputType(uint8_t pushPullMask) {
+  return writeRegisters(CAP1188_LEDOUTTYPE, &pushPullMask, 1);
+}
+
+/*!
+ *   @brief  Programs the pulse, breathe and direct timings of the LED driver
+ *           in three block writes. Once set, effects run on the sensor with
+ *           no further bus traffic.
+ *   @param  config
+ *           LED driver settings
+ *   @return True if the writes succeeded
+ */
+bool Adafruit_CAP1188::setLEDConfig(const cap1188_led_config_t *config) {
+  uint8_t periods[3] = {
+      (uint8_t)((config->pulse1.period & 0x7F) |
+                (config->pulse1OnRelease ? 0x80 : 0)),
+      (uint8_t)(config->pulse2.period & 0x7F),
+      (uint8_t)(config->breathe.period & 0x7F)};
+
+  uint8_t count1 = config->pulse1.count ? config->pulse1.count - 1 : 0;
+  uint8_t count2 = config->pulse2.count ? config->pulse2.count - 1 : 0;
+  uint8_t ledcfg = ((count2 & 0x07) << 3) | (count1 & 0x07);
+
+  uint8_t duty[6] = {
+      (uint8_t)((config->pulse1.maxDuty << 4) | (config->pulse1.minDuty & 0xF)),
+      (uint8_t)((config->pulse2.maxDuty << 4) | (config->pulse2.minDuty & 0xF)),
+      (uint8_t)((config->breathe.maxDuty << 4) |
+                (config->breathe.minDuty & 0xF)),
+      (uint8_t)((config->directMaxDuty << 4) | (config->directMinDuty & 0xF)),
+      (uint8_t)(((config->riseRate & 0x07) << 3) | (config->fallRate & 0x07)),
+      (uint8_t)(((config->breatheOffDelay & 0x07) << 4) |
+                (config->directOffDelay & 0x07))};
+
+  return writeRegisters(CAP1188_LEDPULSE1PER, periods, 3) &&
+         writeRegisters(CAP1188_LEDCFG, &ledcfg, 1) &&
+         writeRegisters(CAP1188_LEDPULSE1DUTY, duty, 6);
+}
+
+/*!
+ *   @brief  Sets the behavior of one LED, without reading it back first
+ *   @param  channel
+ *           LED, 0-7
+ *   @param  behavior
+ *           how the LED is driven when active
+ *   @return True if the write succeeded
+ */
+bool Adafruit_CAP1188::setLEDBehavior(uint8_t channel,
+                                      cap1188_led_behavior_t behavior) {
+  uint8_t reg = (channel >> 2) & 1;
+  uint8_t shift = (channel & 3) * 2;
+  uint8_t value = (configValue(CAP1188_LEDBEHAVIOR1 + reg) & ~(0x03 << shift)) |
+                  ((behavior & 0x03) << shift);
+  return writeRegisters(CAP1188_LEDBEHAVIOR1 + reg, &value, 1);
+}
+
+/*!
+ *   @brief  Sets the behavior of all eight LEDs in one block write
+ *   @param  behaviors
+ *           how each LED is driven when active
+ *   @return True if the write succeeded
+ */
+bool Adafruit_CAP1188::setLEDBehaviors(
+    const cap1188_led_behavior_t behaviors[8]) {
+  uint8_t values[2] = {0, 0};
+  for (uint8_t reg = 0; reg < 2; reg++) {
+    for (uint8_t i = 0; i < 4; i++) {
+      values[reg] |= (behaviors[reg * 4 + i] & 0x03) << (i * 2);
+    }
+  }
+  return writeRegisters(CAP1188_LEDBEHAVIOR1, values, 2);
+}
+
+/*!
+ *   @brief  Links LEDs to, or unlinks them from, their sensor inputs without
+ *           affecting the other LEDs. Linked LEDs follow touches in hardware,
+ *           unlinked LEDs are driven with setLED().
+ *   @param  mask
+ *           LEDs to change, bit 0 is LED 1
+ *   @param  linked
+ *           true to have the LEDs follow touches
+ *   @return True if the write succeeded
+ */
+bool Adafruit_CAP1188::setLEDLinking(uint8_t mask, bool linked) {
+  uint8_t link = configValue(CAP1188_LEDLINK);
+  link = linked ? (link | mask) : (link & ~mask);
+  return writeRegisters(CAP1188_LEDLINK, &link, 1);
+}
+
+/*!
+ *   @brief  Sets the output polarity of LEDs without affecting the others
+ *   @param  mask
+ *           LEDs to change, bit 0 is LED 1
+ *   @param  inverted
+ *           true for inverted (default) polarity, false for non-inverted
+ *   @return True if the write succeeded
+ */
+bool Adafruit_CAP1188::setLEDPolarity(uint8_t mask, bool inverted) {
+  // A '0' in LED Polarity is the inverted (default) output
+  uint8_t polarity = configValue(CAP1188_LEDPOL);
+  polarity = inverted ? (polarity & ~mask) : (polarity | mask);
+  return writeRegisters(CAP1188_LEDPOL, &polarity, 1);
+}
+
+/*!
+ *   @brief  Switches linking, polarity and the host-driven outputs of all
+ *           LEDs in a single block write
+ *   @param  linkMask
+ *           LEDs that follow touches
+ *   @param  invertedMask
+ *           LEDs with inverted polarity
+ *   @param  outputMask
+ *           host-driven LEDs that are active
+ *   @return True if the write succeeded
+ */
+bool Adafruit_CAP1188::setLEDMode(uint8_t linkMask, uint8_t invertedMask,
+                                  uint8_t outputMask) {
+  // Linking, Polarity and Output Control are consecutive
+  uint8_t regs[3] = {linkMask, (uint8_t)~invertedMask, outputMask};
+  if (!writeRegisters(CAP1188_LEDLINK, regs, 3)) {
+    return false;
+  }
+  _ledOutput = outputMask;
+  _ledOutputDirty = false;
+  return true;
+}
+
+/*!
+ *   @brief  Selects linked LEDs that keep their behavior's minimum duty cycle
+ *           when released instead of turning off
+ *   @param  mask
+ *           LEDs to set, bit 0 is LED 1
+ *   @return True if the write succeeded
+ */
+bool Adafruit_CAP1188::setLEDTransition(uint8_t mask) {
+  return writeRegisters(CAP1188_LEDTRANSITION, &mask, 1);
+}
+
+/*!
+ *   @brief  Selects LEDs whose duty cycles are mirrored so that inverted
+ *           polarity LEDs keep the same apparent brightness
+ *   @param  mask
+ *           LEDs to set, bit 0 is LED 1
+ *   @return True if the write succeeded
+ */
+bool Adafruit_CAP1188::setLEDMirror(uint8_t mask) {
+  return writeRegisters(CAP1188_LEDMIRROR, &mask, 1);
+}
+
+/*!
+ *   @brief  Turns a host-driven LED on or off. The change is buffered until
+ *           updateLEDs(), so any number of calls cost a single write.
+ *   @param  channel
+ *           LED, 0-7
+ *   @param  on
+ *           true to activate the LED
+ */
+void Adafruit_CAP1188::setLED(uint8_t channel, bool on) {
+  uint8_t bit = 1 << (channel & 7);
+  setLEDs(on ? (_ledOutput | bit) : (_ledOutput & ~bit));
+}
+
+/*!
+ *   @brief  Sets all host-driven LEDs. The change is buffered until
+ *           updateLEDs().
+ *   @param  mask
+ *           LEDs to activate, bit 0 is LED 1
+ */
+void Adafruit_CAP1188::setLEDs(uint8_t mask) {
+  if (mask != _ledOutput) {
+    _ledOutput = mask;
+    _ledOutputDirty = true;
+  }
+}
+
+/*!
+ *   @brief  Writes the LED changes buffered by setLED() and setLEDs(), if
+ *           any. Call once per frame.
+ *   @return True if nothing was pending or the write succeeded
+ */
+bool Adafruit_CAP1188::updateLEDs() {
+  if (!_ledOutputDirty) {
+    return true;
+  }
+  if (!writeRegisters(CAP1188_LEDOUTPUT, &_ledOutput, 1)) {
+    return false;
+  }
+  _ledOutputDirty = false;
+  return true;
+}
+
+/*!
+ *   @brief  Rewrites every configuration register from the driver's image in
+ *           one block write per run of consecutive registers, e.g. after the
+ *           sensor was reset. The image holds the values last written through
+ *           this driver, and those read by begin().
+ *   @return True if the writes succeeded
+ */
+bool Adafruit_CAP1188::restoreConfig() {
+  const uint8_t *value = _config;
+  for (uint8_t r = 0; r < CAP1188_CONFIG_RUNS; r++) {
+    if (!writeRegisters(configRuns[r].reg, value, configRuns[r].len)) {
+      return false;
+    }
+    value += configRuns[r].len;
+  }
+  return true;
+}
+
+#if CAP1188_HEALTH_CHECK
+/*!
+ *   @brief  Checks that the sensor has not been reset behind the driver's
+ *           back, e.g. by a brown-out, and restores its configuration if it
+ *           has. Costs a single register read while the sensor is healthy.
+ *           A reset is recognised by Standby Configuration, which begin()
+ *           moves off its power-on default, so it must not be set back to
+ *           CAP1188_STANDBYCFG_DEFAULT. Requires CAP1188_HEALTH_CHECK, see
+ *           Adafruit_CAP1188_Config.h.
+ *   @return True if the sensor kept its configuration, false if it was reset
+ *           or could not be read
+ */
+bool Adafruit_CAP1188::checkHealth() {
+  uint8_t sentinel;
+  if (!readRegisters(CAP1188_STANDBYCFG, &sentinel, 1)) {
+    return false;
+  }
+  if (sentinel == configValue(CAP1188_STANDBYCFG)) {
+    return true;
+  }
+  if (_resets != 0xFFFF) {
+    _resets++;
+  }
+  // A reset recalibrates every input and clears the touch status
+  _calPending = 0;
+  _touchState = 0;
+  invalidateFrame();
+  restoreConfig();
+  return false;
+}
+
+/*!
+ *   @brief  Has touched() and readSnapshot() call checkHealth() every few
+ *           polls, so that a reset sensor is reconfigured without a separate
+ *           timer in the sketch
+ *   @param  polls
+ *           polls between two checks, 0 (default) to never check
+ */
+void Adafruit_CAP1188::setHealthCheck(uint16_t polls) {
+  _healthInterval = polls;
+  _healthPolls = 0;
+}
+
+/*!
+ *   @brief  Counts a poll and runs the health check when it is due
+ */
+void Adafruit_CAP1188::pollHealth() {
+  if (_healthInterval && ++_healthPolls >= _healthInterval) {
+    _healthPolls = 0;
+    checkHealth();
+  }
+}
+#endif
+
+/*!
+ *   @brief  Reads every documented register in one burst per range, for
+ *           diagnostics or to clone the configuration to another sensor with
+ *           restoreRegisters()
+ *   @param  dump
+ *           filled with CAP1188_DUMP_SIZE bytes, see Adafruit_CAP1188_Dump.h
+ *   @return True if the reads succeeded
+ */
+bool Adafruit_CAP1188::dumpRegisters(uint8_t *dump) {
+  for (uint8_t r = 0; r < CAP1188_DUMP_RANGES; r++) {
+    const cap1188_dump_range_t *range = &Adafruit_CAP1188_Dump::ranges[r];
+    uint8_t *values = &dump[Adafruit_CAP1188_Dump::offset(range->reg)];
+    if (!readRegisters(range->reg, values, range->len)) {
+      return false;
+    }
+  }
+  Adafruit_CAP1188_Dump::seal(dump);
+  return true;
+}
+
+/*!
+ *   @brief  Writes back the writable registers of a dump taken with
+ *           dumpRegisters(), in one block write per run of consecutive
+ *           writable registers. Status, counts and IDs are skipped. The
+ *           LED outputs set with setLED(), the interrupt policy and the
+ *           cached touch status follow the restored registers.
+ *   @param  dump
+ *           CAP1188_DUMP_SIZE bytes
+ *   @return False if the dump is corrupt, not from a CAP1188 or a write
+ *           failed
+ */
+bool Adafruit_CAP1188::restoreRegisters(const uint8_t *dump) {
+  if (!Adafruit_CAP1188_Dump::valid(dump) ||
+      !isCAP1188(&dump[Adafruit_CAP1188_Dump::offset(CAP1188_PRODID)])) {
+    return false;
+  }
+  // Keep the power state and gain, but not a pending interrupt
+  uint8_t main =
+      dump[Adafruit_CAP1188_Dump::offset(CAP1188_MAIN)] & ~CAP1188_MAIN_INT;
+  if (!writeRegisters(CAP1188_MAIN, &main, 1)) {
+    return false;
+  }
+  for (uint8_t r = 0; r < CAP1188_CONFIG_RUNS; r++) {
+    const uint8_t *values =
+        &dump[Adafruit_CAP1188_Dump::offset(configRuns[r].reg)];
+    if (!writeRegisters(configRuns[r].reg, values, configRuns[r].len)) {
+      return false;
+    }
+  }
+  // Follow the restored LED outputs and interrupt policy
+  _ledOutput = configValue(CAP1188_LEDOUTPUT);
+  _ledOutputDirty = false;
+  _intOnRelease = !(configValue(CAP1188_CONFIG2) & CAP1188_CONFIG2_INT_REL_N);
+  invalidateFrame();
+  if (_intDriven) {
+    // Clearing INT dropped the latched status of released inputs
+    _touchState = readRegister(CAP1188_SENINPUTSTATUS) & getInputEnable();
+  }
+  return true;
+}
+
+#if CAP1188_STORED_CONFIG
+/*!
+ *   @brief  Selects where saveConfig() keeps the configuration profile that
+ *           begin() applies, e.g. thresholds tuned for this unit. Call before
+ *           begin(). Requires CAP1188_STORED_CONFIG, see
+ *           Adafruit_CAP1188_Config.h.
+ *   @param  storage
+ *           profile storage, or NULL for none
+ */
+void Adafruit_CAP1188::setStorage(Adafruit_CAP1188_Storage *storage) {
+  _storage = storage;
+}
+
+/*!
+ *   @brief  Stores the current configuration as the profile begin() applies
+ *   @return True if the profile was written to the storage
+ */
+bool Adafruit_CAP1188::saveConfig() {
+  if (!_storage) {
+    return false;
+  }
+  uint8_t profile[CAP1188_PROFILE_SIZE] = {'C', 'P', CAP1188_PROFILE_VERSION,
+                                           CAP1188_CONFIG_SIZE};
+  memcpy(&profile[4], _config, CAP1188_CONFIG_SIZE);
+  uint16_t crc = Adafruit_CAP1188_Dump::crc16(profile, sizeof(profile) - 2);
+  profile[sizeof(profile) - 2] = crc & 0xFF;
+  profile[sizeof(profile) - 1] = crc >> 8;
+  return _storage->write(profile, sizeof(profile));
+}
+
+/*!
+ *   @brief  Applies the stored profile in one block write per run of
+ *           consecutive configuration registers. Nothing is written if the
+ *           sensor already runs the profile.
+ *   @return False if no intact profile of this version is stored or a write
+ *           failed
+ */
+bool Adafruit_CAP1188::loadConfig() {
+  uint8_t image[CAP1188_CONFIG_SIZE];
+  if (!_storage || !readProfile(image)) {
+    return false;
+  }
+  if (memcmp(image, _config, CAP1188_CONFIG_SIZE) == 0) {
+    return true;
+  }
+  memcpy(_config, image, CAP1188_CONFIG_SIZE);
+  if (!restoreConfig()) {
+    return false;
+  }
+  _ledOutput = configValue(CAP1188_LEDOUTPUT);
+  _ledOutputDirty = false;
+  return true;
+}
+
+/*!
+ *   @brief  Reads and checks the stored profile
+ *   @param  image
+ *           filled with the profile's configuration image if it is intact
+ *   @return True if an intact profile of this version is stored
+ */
+bool Adafruit_CAP1188::readProfile(uint8_t image[CAP1188_CONFIG_SIZE]) {
+  uint8_t profile[CAP1188_PROFILE_SIZE];
+  if (!_storage->read(profile, sizeof(profile)) || profile[0] != 'C' ||
+      profile[1] != 'P' || profile[2] != CAP1188_PROFILE_VERSION ||
+      profile[3] != CAP1188_CONFIG_SIZE) {
+    return false;
+  }
+  uint16_t crc = Adafruit_CAP1188_Dump::crc16(profile, sizeof(profile) - 2);
+  if (profile[sizeof(profile) - 2] != (crc & 0xFF) ||
+      profile[sizeof(profile) - 1] != (crc >> 8)) {
+    return false;
+  }
+  memcpy(image, &profile[4], CAP1188_CONFIG_SIZE);
+  return true;
+}
+#endif
+
+/*!
+ *   @brief  Finds a register in the configuration image
+ *   @param  reg
+ *           register address
+ *   @return Offset of the register in the image, -1 if it is not a
+ *           configuration register
+ */
+int8_t Adafruit_CAP1188::configIndex(uint8_t reg) {
+  uint8_t index = 0;
+  for (uint8_t r = 0; r < CAP1188_CONFIG_RUNS; r++) {
+    uint8_t offset = reg - configRuns[r].reg;
+    if (reg >= configRuns[r].reg && offset < configRuns[r].len) {
+      return index + offset;
+    }
+    index += configRuns[r].len;
+  }
+  return -1;
+}
+
+/*!
+ *   @brief  Gets a configuration register from the image, without bus
+ *           traffic
+ *   @param  reg
+ *           configuration register address
+ *   @return The register value as last written or read by begin()
+ */
+uint8_t Adafruit_CAP1188::configValue(uint8_t reg) {
+  int8_t index = configIndex(reg);
+  return index >= 0 ? _config[index] : 0;
+}
+
+/*!
+ *   @brief  Reads every configuration register from the sensor in two bursts
+ *   @param  image
+ *           filled with the registers in configuration image order
+ *   @return True if the reads succeeded
+ */
+bool Adafruit_CAP1188::readConfig(uint8_t image[CAP1188_CONFIG_SIZE]) {
+  // Each burst spans several runs along with the reserved registers between
+  // them, which are discarded
+  static const uint8_t bursts[2][2] = {{CAP1188_SENSITIVITY, CAP1188_CONFIG2},
+                                       {CAP1188_LEDOUTTYPE, 0x95}};
+  uint8_t buffer[CAP1188_CONFIG2 - CAP1188_SENSITIVITY + 1];
+  uint8_t r = 0;
+  for (uint8_t b = 0; b < 2; b++) {
+    uint8_t first = bursts[b][0];
+    if (!readRegisters(first, buffer, bursts[b][1] - first + 1)) {
+      return false;
+    }
+    for (; r < CAP1188_CONFIG_RUNS && configRuns[r].reg <= bursts[b][1]; r++) {
+      memcpy(image, &buffer[configRuns[r].reg - first], configRuns[r].len);
+      image += configRuns[r].len;
+    }
+  }
+  return true;
+}
+
 /*!
  *    @brief  Reads from selected register
  *    @param  reg
  *            register address
- *    @return
+ *    @return The register value, 0 if the read failed
  */
 uint8_t Adafruit_CAP1188::readRegister(uint8_t reg) {
-  uint8_t buffer[3] = {reg, 0, 0};
-  if (i2c_dev) {
-    i2c_dev->write_then_read(buffer, 1, buffer, 1);
-  } else {
-    buffer[0] = 0x7D;
-    buffer[1] = reg;
-    buffer[2] = 0x7F;
-    spi_dev->write_then_read(buffer, 3, buffer, 1);
-  }
-  return buffer[0];
+  uint8_t value = 0;
+  readRegisters(reg, &value, 1);
+  return value;
 }
 
 /*!
@@ -189,14 +1525,144 @@ uint8_t Adafruit_CAP1188::readRegister(uint8_t reg) {
  *           value that will be written at selected register
  */
 void Adafruit_CAP1188::writeRegister(uint8_t reg, uint8_t value) {
-  uint8_t buffer[4] = {reg, value, 0, 0};
-  if (i2c_dev) {
-    i2c_dev->write(buffer, 2);
+  writeRegisters(reg, &value, 1);
+}
+
+/*!
+ *   @brief  Reads a block of consecutive registers in one burst
+ *   @param  reg
+ *           first register address
+ *   @param  buffer
+ *           destination for the register values
+ *   @param  len
+ *           number of registers to read
+ *   @return True if the read succeeded
+ */
+bool Adafruit_CAP1188::readRegisters(uint8_t reg, uint8_t *buffer,
+                                     uint8_t len) {
+  if (!hasBus()) {
+    return false;
+  }
+  // A single register read over I2C leaves the address pointer on that
+  // register, so polling it again needs no address phase
+  bool current = !spi_dev && _addrPtr == reg;
+#if CAP1188_BUS_TRACE
+  uint8_t op = current ? CAP1188_TRACE_READ_CURRENT : CAP1188_TRACE_READ;
+#endif
+#if CAP1188_BUS_STATS
+  // BusIO splits a read longer than its buffer into chunks, each after a
+  // repeated start and the address
+  uint8_t splits = 0;
+  if (i2c_dev && !replaying() && len) {
+    splits = (len - 1) / i2c_dev->maxBufferSize();
+  }
+  if (current) {
+    // Address, then the data bytes
+    countTransaction(1 + len + splits, 2 + splits);
+  } else if (spi_dev) {
+    // Set address, register, read data, then the data bytes
+    countTransaction(3 + len, 0);
+  } else {
+    // Address, register, repeated start, address, then the data bytes
+    countTransaction(3 + len + splits, 3 + splits);
+  }
+#endif
+
+  bool ok = false;
+  if (replaying()) {
+#if CAP1188_BUS_TRACE
+    ok = _trace->play(op, reg, buffer, len);
+#endif
+  } else if (current) {
+    ok = i2c_dev->read(buffer, len);
+  } else if (i2c_dev) {
+    ok = i2c_dev->write_then_read(&reg, 1, buffer, len);
   } else {
-    buffer[0] = 0x7D;
-    buffer[1] = reg;
-    buffer[2] = 0x7E;
-    buffer[3] = value;
-    spi_dev->write(buffer, 4);
+    // Every 'read data' command returns the next register
+    uint8_t cmd[3] = {0x7D, reg, 0x7F};
+    ok = spi_dev->write_then_read(cmd, 3, buffer, len, 0x7F);
   }
+#if CAP1188_BUS_TRACE
+  if (_trace && !replaying()) {
+    _trace->log(op | (ok ? 0 : CAP1188_TRACE_FAILED), reg, buffer, len,
+                micros());
+  }
+#endif
+  // Over SPI every 'read data' command advances the pointer, and block reads
+  // advance it on both buses
+  _addrPtr = (ok && !spi_dev && len == 1) ? reg : -1;
+  return ok;
+}
+
+/*!
+ *   @brief  Writes a block of consecutive registers, split into as few bus
+ *           transactions as the bus buffer allows
+ *   @param  reg
+ *           first register address
+ *   @param  buffer
+ *           values to write
+ *   @param  len
+ *           number of registers to write
+ *   @return True if the write succeeded
+ */
+bool Adafruit_CAP1188::writeRegisters(uint8_t reg, const uint8_t *buffer,
+                                      uint8_t len) {
+  if (!hasBus()) {
+    return false;
+  }
+  _addrPtr = -1;
+  while (len) {
+    uint8_t chunk = len;
+    bool ok = false;
+    if (replaying()) {
+#if CAP1188_BUS_TRACE
+      // Replay in the same transactions as the trace was recorded
+      uint8_t max = _trace->pending();
+      chunk = (max && len > max) ? max : len;
+      ok = _trace->play(CAP1188_TRACE_WRITE, reg, (uint8_t *)buffer, chunk);
+#endif
+    } else if (i2c_dev) {
+      size_t max = i2c_dev->maxBufferSize() - 1;
+      chunk = len > max ? max : len;
+      ok = i2c_dev->write(buffer, chunk, true, &reg, 1);
+    } else {
+      // Every 'write data' command is followed by its value
+      uint8_t cmd[2 + 2 * 16];
+      chunk = len > 16 ? 16 : len;
+      cmd[0] = 0x7D;
+      cmd[1] = reg;
+      for (uint8_t i = 0; i < chunk; i++) {
+        cmd[2 + 2 * i] = 0x7E;
+        cmd[3 + 2 * i] = buffer[i];
+      }
+      ok = spi_dev->write(cmd, 2 + 2 * chunk);
+    }
+#if CAP1188_BUS_STATS
+    if (spi_dev) {
+      // Set address, register, then a write data command per value
+      countTransaction(2 + 2 * chunk, 0);
+    } else {
+      countTransaction(2 + chunk, 2);
+    }
+#endif
+#if CAP1188_BUS_TRACE
+    if (_trace && !replaying()) {
+      _trace->log(CAP1188_TRACE_WRITE | (ok ? 0 : CAP1188_TRACE_FAILED), reg,
+                  buffer, chunk, micros());
+    }
+#endif
+    if (!ok) {
+      return false;
+    }
+    for (uint8_t i = 0; i < chunk; i++) {
+      int8_t index = configIndex(reg + i);
+      if (index >= 0) {
+        _config[index] = buffer[i];
+      }
+    }
+    reg += chunk;
+    buffer += chunk;
+    len -= chunk;
+  }
+  return true;
 }
@@ -20,11 +20,24 @@
  *  BSD license, all text above must be included in any redistribution
  */
 
+#ifndef ADAFRUIT_CAP1188_H
+#define ADAFRUIT_CAP1188_H
+
 #include "Arduino.h"
 #include <Adafruit_I2CDevice.h>
 #include <Adafruit_SPIDevice.h>
 
+#include "Adafruit_CAP1188_Config.h"
+#include "Adafruit_CAP1188_Dump.h"
+
+class Adafruit_CAP1188_SampleRing;
+class Adafruit_CAP1188_BusTrace;
+class Adafruit_CAP1188_Storage;
+class Adafruit_CAP1188_Latency;
+
 #define CAP1188_I2CADDR 0x29 ///< The default I2C address
+#define CAP1188_I2CADDR_MIN 0x28 ///< Lowest address selectable on ADDR_COMM
+#define CAP1188_I2CADDR_MAX 0x2C ///< Highest address selectable on ADDR_COMM
 
 // Some registers we use
 #define CAP1188_SENINPUTSTATUS                                                 \
@@ -32,11 +45,31 @@
       ///< touch has been detected. A value of ‘0’ in any bit indicates that no
       ///< touch has been detected. A value of ‘1’ in any bit indicates that a
       ///< touch has been detected.
+#define CAP1188_GENSTATUS                                                      \
+  0x2 ///< General Status register. Stores the multiple touch pattern (MTP),
+      ///< multiple touch block (MULT), LED and TOUCH status bits.
+#define CAP1188_NOISEFLAG                                                      \
+  0xA ///< Noise Flag Status register. A '1' indicates that the noise threshold
+      ///< was exceeded on that input and touches on it were blocked.
 #define CAP1188_MTBLK                                                          \
   0x2A ///< Multiple Touch Configuration register controls the settings for the
        ///< multiple touch detection circuitry. These settings determine the
        ///< number of simultaneous buttons that may be pressed before additional
        ///< buttons are blocked and the MULT status bit is set. [0/1]
+#define CAP1188_MTPCFG                                                         \
+  0x2B ///< Multiple Touch Pattern Configuration. Enables the multiple touch
+       ///< pattern detection circuitry and its alert.
+#define CAP1188_MTPATTERN                                                      \
+  0x2D ///< Multiple Touch Pattern register. The inputs that form the pattern,
+       ///< or the number of inputs when comparing against a count.
+#define CAP1188_CONFIG2                                                        \
+  0x44 ///< Configuration 2. Controls the ALERT polarity, noise detection and
+       ///< whether releases generate an interrupt (INT_REL_n).
+#define CAP1188_CONFIG2_INT_REL_N                                              \
+  0x01 ///< Configuration 2 bit that disables the interrupt on release
+#define CAP1188_LEDOUTTYPE                                                     \
+  0x71 ///< LED Output Type. A '1' selects a push-pull output, a '0' an
+       ///< open-drain output.
 #define CAP1188_LEDLINK                                                        \
   0x72 ///< Sensor Input LED Linking. Controls linking of sensor inputs to LED
        ///< channels
@@ -44,9 +77,14 @@
   0xFD ///< Product ID. Stores a fixed value that identifies each product.
 #define CAP1188_MANUID                                                         \
   0xFE ///< Manufacturer ID. Stores a fixed value that identifies SMSC
+#define CAP1188_STANDBYCHAN                                                    \
+  0x40 ///< Standby Channel. Inputs sampled while in standby; Standby
+       ///< Configuration, Sensitivity and Threshold follow at 0x41-0x43.
 #define CAP1188_STANDBYCFG                                                     \
   0x41 ///< Standby Configuration. Controls averaging and cycle time while in
        ///< standby.
+#define CAP1188_STANDBYCFG_DEFAULT                                             \
+  0x39 ///< Power-on value of Standby Configuration, which begin() changes
 #define CAP1188_REV                                                            \
   0xFF ///< Revision register. Stores an 8-bit value that represents the part
        ///< revision.
@@ -55,8 +93,235 @@
        ///< device.
 #define CAP1188_MAIN_INT                                                       \
   0x01 ///< Main Control Int register. Indicates that there is an interrupt.
+#define CAP1188_GENSTATUS_TOUCH 0x01 ///< At least one input is touched
+#define CAP1188_GENSTATUS_MULT                                                 \
+  0x04 ///< More simultaneous touches than allowed, touches are blocked
+#define CAP1188_GENSTATUS_MTP 0x08 ///< Multiple touch pattern matched
 #define CAP1188_LEDPOL                                                         \
   0x73 ///< LED Polarity. Controls the output polarity of LEDs.
+#define CAP1188_LEDOUTPUT                                                      \
+  0x74 ///< LED Output Control. Drives LEDs that are not linked to an input.
+#define CAP1188_LEDTRANSITION                                                  \
+  0x77 ///< Linked LED Transition Control. Controls the transition of linked
+       ///< LEDs when their input is released.
+#define CAP1188_LEDMIRROR                                                      \
+  0x79 ///< LED Mirror Control. Inverts the duty cycle of LEDs driven with
+       ///< inverted polarity.
+#define CAP1188_LEDBEHAVIOR1                                                   \
+  0x81 ///< LED Behavior 1. Two bits per LED for LEDs 1-4; LED Behavior 2 for
+       ///< LEDs 5-8 follows at 0x82.
+#define CAP1188_LEDPULSE1PER                                                   \
+  0x84 ///< LED Pulse 1 Period. Pulse 2 Period and Breathe Period follow at
+       ///< 0x85 and 0x86.
+#define CAP1188_LEDCFG                                                         \
+  0x88 ///< LED Config. Number of pulses for the pulse behaviors.
+#define CAP1188_LEDPULSE1DUTY                                                  \
+  0x90 ///< LED Pulse 1 Duty Cycle. Pulse 2, Breathe and Direct duty cycles,
+       ///< Direct Ramp Rates and Off Delay follow at 0x91-0x95.
+#define CAP1188_DELTA1                                                         \
+  0x10 ///< Sensor Input 1 Delta Count. Signed delta from the base count; the
+       ///< counts for inputs 2-8 follow at 0x11-0x17.
+#define CAP1188_SENSITIVITY                                                    \
+  0x1F ///< Sensitivity Control register. Controls the sensitivity of a touch
+       ///< detection (DELTA_SENSE) and the base count data scaling
+       ///< (BASE_SHIFT).
+#define CAP1188_SENINPUTEN                                                     \
+  0x21 ///< Sensor Input Enable. A '0' removes the input from the sensing
+       ///< cycle.
+#define CAP1188_AVGSAMPLE                                                      \
+  0x24 ///< Averaging and Sampling Configuration. Controls the number of
+       ///< samples averaged, the sample time and the cycle time.
+#define CAP1188_INTENABLE                                                      \
+  0x27 ///< Interrupt Enable. A '1' lets the input assert the interrupt.
+#define CAP1188_REPEATEN                                                       \
+  0x28 ///< Repeat Rate Enable. A '1' repeats the interrupt while the input is
+       ///< held.
+#define CAP1188_CALACTIVE                                                      \
+  0x26 ///< Calibration Activate. Writing a '1' to a bit starts calibration of
+       ///< that input; the bit clears once calibration has completed.
+#define CAP1188_RECALCFG                                                       \
+  0x2F ///< Recalibration Configuration. Controls automatic recalibration.
+#define CAP1188_BASECOUNT1                                                     \
+  0x50 ///< Sensor Input 1 Base Count. The base counts for inputs 2-8 follow at
+       ///< 0x51-0x57.
+#define CAP1188_THRESH1                                                        \
+  0x30 ///< Sensor Input 1 Threshold. The thresholds for inputs 2-8 follow at
+       ///< 0x31-0x37.
+#define CAP1188_NOISETHRESH                                                    \
+  0x38 ///< Sensor Input Noise Threshold. Controls the percentage of the touch
+       ///< threshold used to flag noise.
+
+#define CAP1188_CONFIG_SIZE                                                    \
+  44 ///< Number of writable configuration registers, from Sensitivity Control
+     ///< (0x1F) to LED Off Delay (0x95)
+#define CAP1188_PROFILE_VERSION 1 ///< Format version of stored profiles
+#define CAP1188_PROFILE_SIZE                                                   \
+  (4 + CAP1188_CONFIG_SIZE + 2) ///< Bytes in a stored profile: "CP", version
+                                ///< and size, the configuration, and a CRC
+
+/*!
+ *    @brief  Status of the sensor captured in a single burst read
+ */
+typedef struct {
+  uint8_t touched;     ///< Sensor Input Status, bit 0 is input 1
+  uint8_t noise;       ///< Noise Flag Status, bit 0 is input 1
+  uint8_t status;      ///< General Status (CAP1188_GENSTATUS_* bits)
+  uint8_t calibrating; ///< Inputs whose requested calibration has not been
+                       ///< seen to complete
+} cap1188_snapshot_t;
+
+/*!
+ *    @brief  How an LED is driven when active
+ */
+typedef enum {
+  CAP1188_LED_DIRECT = 0,  ///< On/off, with optional ramps (default)
+  CAP1188_LED_PULSE1 = 1,  ///< Pulses when triggered
+  CAP1188_LED_PULSE2 = 2,  ///< Pulses while active
+  CAP1188_LED_BREATHE = 3, ///< Breathes while active
+} cap1188_led_behavior_t;
+
+/*!
+ *    @brief  Timing and brightness of one hardware LED effect
+ */
+typedef struct {
+  uint8_t period;  ///< Period in 32 ms units, 1-127
+  uint8_t count;   ///< Pulses per trigger, 1-8 (pulse effects only)
+  uint8_t maxDuty; ///< Maximum duty cycle code, 0 (7%) - 15 (100%)
+  uint8_t minDuty; ///< Minimum duty cycle code, 0 (0%) - 15 (77%)
+} cap1188_led_effect_t;
+
+/*!
+ *    @brief  Settings of the LED driver shared by all LEDs
+ */
+typedef struct {
+  cap1188_led_effect_t pulse1;  ///< Used by CAP1188_LED_PULSE1
+  cap1188_led_effect_t pulse2;  ///< Used by CAP1188_LED_PULSE2
+  cap1188_led_effect_t breathe; ///< Used by CAP1188_LED_BREATHE
+  uint8_t directMaxDuty;        ///< Direct behavior on duty cycle code, 0-15
+  uint8_t directMinDuty;        ///< Direct behavior off duty cycle code, 0-15
+  uint8_t riseRate;             ///< Direct rise ramp, 0 (none) - 7 (2000 ms)
+  uint8_t fallRate;             ///< Direct fall ramp, 0 (none) - 7 (2000 ms)
+  uint8_t breatheOffDelay;      ///< Breathe off delay, 0 (none) - 7 (longest)
+  uint8_t directOffDelay;       ///< Direct off delay, 0 (none) - 7 (longest)
+  bool pulse1OnRelease;         ///< Pulse 1 triggers on release, not touch
+} cap1188_led_config_t;
+
+/*!
+ *    @brief  Bus traffic generated by the driver
+ */
+typedef struct {
+  uint32_t transactions; ///< Bus transactions
+  uint32_t bytes;        ///< Bytes on the wire, including address and command
+                         ///< bytes
+  uint32_t bits;         ///< Clock cycles on the wire, including I2C ACK,
+                         ///< start and stop conditions
+} cap1188_bus_stats_t;
+
+/*!
+ *    @brief  Touch detection sensitivity (DELTA_SENSE), from most sensitive
+ *            (128x) to least sensitive (1x)
+ */
+typedef enum {
+  CAP1188_SENSITIVITY_128X = 0, ///< Most sensitive
+  CAP1188_SENSITIVITY_64X = 1,  ///< 64x
+  CAP1188_SENSITIVITY_32X = 2,  ///< Power-on default
+  CAP1188_SENSITIVITY_16X = 3,  ///< 16x
+  CAP1188_SENSITIVITY_8X = 4,   ///< 8x
+  CAP1188_SENSITIVITY_4X = 5,   ///< 4x
+  CAP1188_SENSITIVITY_2X = 6,   ///< 2x
+  CAP1188_SENSITIVITY_1X = 7,   ///< Least sensitive
+} cap1188_sensitivity_t;
+
+/*!
+ *    @brief  Noise threshold, as a percentage of the touch threshold
+ */
+typedef enum {
+  CAP1188_NOISE_25_PERCENT = 0,   ///< 25% of the touch threshold
+  CAP1188_NOISE_37_5_PERCENT = 1, ///< Power-on default
+  CAP1188_NOISE_50_PERCENT = 2,   ///< 50% of the touch threshold
+  CAP1188_NOISE_62_5_PERCENT = 3, ///< 62.5% of the touch threshold
+} cap1188_noise_threshold_t;
+
+/*!
+ *    @brief  Touch events that assert the interrupt
+ */
+typedef enum {
+  CAP1188_INT_PRESS = 0,         ///< Touches only
+  CAP1188_INT_PRESS_RELEASE = 1, ///< Touches and releases
+  CAP1188_INT_PRESS_REPEAT_RELEASE =
+      2, ///< Touches, repeatedly while held, and releases (power-on default)
+} cap1188_int_policy_t;
+
+/*!
+ *    @brief  Number of samples averaged per measurement
+ */
+typedef enum {
+  CAP1188_AVG_1 = 0,   ///< 1 sample
+  CAP1188_AVG_2 = 1,   ///< 2 samples
+  CAP1188_AVG_4 = 2,   ///< 4 samples
+  CAP1188_AVG_8 = 3,   ///< Power-on default
+  CAP1188_AVG_16 = 4,  ///< 16 samples
+  CAP1188_AVG_32 = 5,  ///< 32 samples
+  CAP1188_AVG_64 = 6,  ///< 64 samples
+  CAP1188_AVG_128 = 7, ///< 128 samples
+} cap1188_averaging_t;
+
+/*!
+ *    @brief  Time taken by a single sample
+ */
+typedef enum {
+  CAP1188_SAMPLE_320US = 0,  ///< 320 us
+  CAP1188_SAMPLE_640US = 1,  ///< 640 us
+  CAP1188_SAMPLE_1280US = 2, ///< Power-on default
+  CAP1188_SAMPLE_2560US = 3, ///< 2.56 ms
+} cap1188_sample_time_t;
+
+/*!
+ *    @brief  Programmed time between the start of two sensing cycles
+ */
+typedef enum {
+  CAP1188_CYCLE_35MS = 0,  ///< 35 ms
+  CAP1188_CYCLE_70MS = 1,  ///< Power-on default
+  CAP1188_CYCLE_105MS = 2, ///< 105 ms
+  CAP1188_CYCLE_140MS = 3, ///< 140 ms
+} cap1188_cycle_time_t;
+
+/*!
+ *    @brief  Fraction of the touch threshold an input must exceed to count
+ *            towards a multiple touch pattern (MTP_TH)
+ */
+typedef enum {
+  CAP1188_MTP_12_5_PERCENT = 0, ///< Power-on default
+  CAP1188_MTP_25_PERCENT = 1,   ///< 25% of the touch threshold
+  CAP1188_MTP_37_5_PERCENT = 2, ///< 37.5% of the touch threshold
+  CAP1188_MTP_100_PERCENT = 3,  ///< Same as a touch
+} cap1188_mtp_threshold_t;
+
+/*!
+ *    @brief  Number of consecutive negative delta readings that trigger a
+ *            digital recalibration (NEG_DELTA_CNT)
+ */
+typedef enum {
+  CAP1188_NEG_DELTA_8 = 0,    ///< 8 readings
+  CAP1188_NEG_DELTA_16 = 1,   ///< Power-on default
+  CAP1188_NEG_DELTA_32 = 2,   ///< 32 readings
+  CAP1188_NEG_DELTA_NONE = 3, ///< Never recalibrate on negative delta
+} cap1188_neg_delta_count_t;
+
+/*!
+ *    @brief  Automatic recalibration averaging samples and update time
+ *            (CAL_CFG), named as samples_updatetime
+ */
+typedef enum {
+  CAP1188_RECAL_16_16 = 0,    ///< 16 samples, updated every 16 cycles
+  CAP1188_RECAL_32_32 = 1,    ///< 32 samples, updated every 32 cycles
+  CAP1188_RECAL_64_64 = 2,    ///< Power-on default
+  CAP1188_RECAL_128_128 = 3,  ///< 128 samples, updated every 128 cycles
+  CAP1188_RECAL_256_256 = 4,  ///< 256 samples, updated every 256 cycles
+  CAP1188_RECAL_256_1024 = 5, ///< 256 samples, updated every 1024 cycles
+  CAP1188_RECAL_256_2048 = 6, ///< 256 samples, updated every 2048 cycles
+  CAP1188_RECAL_256_4096 = 7, ///< 256 samples, updated every 4096 cycles
+} cap1188_recal_config_t;
 
 /*!
  *    @brief  Class that stores state and functions for interacting with
@@ -73,13 +338,204 @@ public:
   Adafruit_CAP1188(int8_t resetpin = -1);
 
   boolean begin(uint8_t i2caddr = CAP1188_I2CADDR, TwoWire *theWire = &Wire);
+  void setWarmStart(bool enable);
+  static uint8_t probe(TwoWire *theWire = &Wire);
+  bool warmStarted() { return _warmStarted; } ///< begin() kept the config
   uint8_t readRegister(uint8_t reg);
   void writeRegister(uint8_t reg, uint8_t value);
+  bool readRegisters(uint8_t reg, uint8_t *buffer, uint8_t len);
+  bool writeRegisters(uint8_t reg, const uint8_t *buffer, uint8_t len);
   uint8_t touched();
+#if CAP1188_FRAME_CACHE
+  void setFrameCache(bool enable);
+  void invalidateFrame();
+#else
+  void invalidateFrame() {} ///< touched() reads the sensor on every call
+#endif
+  bool setInterruptPolicy(cap1188_int_policy_t policy);
+  void setAlertPin(int8_t pin);
+  bool readSnapshot(cap1188_snapshot_t *snapshot);
+#if CAP1188_NOISE_EVENTS
+  uint16_t noiseEvents(uint8_t channel);
+  void resetNoiseEvents();
+#endif
+#if CAP1188_SAMPLE_RING
+  void setSampleRing(Adafruit_CAP1188_SampleRing *ring);
+#endif
+#if CAP1188_BUS_TRACE
+  void setBusTrace(Adafruit_CAP1188_BusTrace *trace);
+#endif
+#if CAP1188_BUS_STATS
+  void getBusStats(cap1188_bus_stats_t *stats);
+  void resetBusStats();
+  static uint32_t wireTime(const cap1188_bus_stats_t *stats, uint32_t clock);
+#endif
+#if CAP1188_LATENCY
+  void setLatencyHistogram(Adafruit_CAP1188_Latency *histogram);
+  void alertEdge();
+#endif
   void LEDpolarity(uint8_t x);
 
+  bool setLEDOutputType(uint8_t pushPullMask);
+  bool setLEDConfig(const cap1188_led_config_t *config);
+  bool setLEDBehavior(uint8_t channel, cap1188_led_behavior_t behavior);
+  bool setLEDBehaviors(const cap1188_led_behavior_t behaviors[8]);
+  bool setLEDLinking(uint8_t mask, bool linked);
+  bool setLEDPolarity(uint8_t mask, bool inverted);
+  bool setLEDMode(uint8_t linkMask, uint8_t invertedMask, uint8_t outputMask);
+  bool setLEDTransition(uint8_t mask);
+  bool setLEDMirror(uint8_t mask);
+  void setLED(uint8_t channel, bool on);
+  void setLEDs(uint8_t mask);
+  bool updateLEDs();
+
+  bool setThresholds(const uint8_t thresholds[8]);
+  bool getThresholds(uint8_t thresholds[8]);
+  bool setNoiseThreshold(cap1188_noise_threshold_t noise);
+  cap1188_noise_threshold_t getNoiseThreshold();
+  bool setSensitivity(cap1188_sensitivity_t sensitivity,
+                      uint8_t baseShift = 0xF);
+  cap1188_sensitivity_t getSensitivity();
+  uint8_t getBaseShift();
+
+  bool setInputEnable(uint8_t mask);
+  /*!
+   *   @brief  Gets the inputs that are sampled
+   *   @return Sensor Input Enable as last written or read by begin()
+   */
+  uint8_t getInputEnable() {
+    // The image starts at Sensitivity Control
+    return _config[CAP1188_SENINPUTEN - CAP1188_SENSITIVITY];
+  }
+  bool setSampling(cap1188_averaging_t averaging,
+                   cap1188_sample_time_t sampleTime,
+                   cap1188_cycle_time_t cycleTime);
+  uint32_t cycleTime();
+  uint32_t maxLatency();
+
+  bool calibrate(uint8_t channelMask = 0xFF);
+  bool calibrationDone(uint8_t baseCounts[8] = NULL);
+  bool calibrateAndWait(uint8_t channelMask = 0xFF, uint16_t timeout = 600,
+                        uint8_t baseCounts[8] = NULL);
+  bool setRecalibration(cap1188_neg_delta_count_t negDelta,
+                        cap1188_recal_config_t config,
+                        bool thresholdLink = true,
+                        bool clearIntermediate = true,
+                        bool clearNegative = true);
+  bool readBaseCounts(uint8_t counts[8]);
+  bool readDeltas(int8_t deltas[8]);
+
+  bool
+  setTouchPattern(uint8_t pattern,
+                  cap1188_mtp_threshold_t threshold = CAP1188_MTP_100_PERCENT);
+  bool
+  setTouchLimit(uint8_t maxTouches,
+                cap1188_mtp_threshold_t threshold = CAP1188_MTP_100_PERCENT);
+  bool disableTouchPattern();
+
+  bool restoreConfig();
+#if CAP1188_HEALTH_CHECK
+  bool checkHealth();
+  void setHealthCheck(uint16_t polls);
+  uint16_t resetCount() { return _resets; } ///< Resets seen by checkHealth()
+#endif
+  bool dumpRegisters(uint8_t *dump);
+#if CAP1188_STORED_CONFIG
+  void setStorage(Adafruit_CAP1188_Storage *storage);
+  bool saveConfig();
+  bool loadConfig();
+  bool storedConfig() { return _storedConfig; } ///< begin() used the profile
+#endif
+  bool restoreRegisters(const uint8_t *dump);
+
 private:
+  uint8_t readInputStatus();
+#if CAP1188_NOISE_EVENTS
+  void countNoise(uint8_t noise);
+#endif
+#if CAP1188_FRAME_CACHE
+  bool frameFresh();
+  void storeFrame(uint8_t touched);
+#endif
+  bool configuredSinceReset();
+#if CAP1188_STORED_CONFIG
+  bool readProfile(uint8_t image[CAP1188_CONFIG_SIZE]);
+#endif
+  static int8_t configIndex(uint8_t reg);
+  uint8_t configValue(uint8_t reg);
+  bool readConfig(uint8_t image[CAP1188_CONFIG_SIZE]);
+#if CAP1188_HEALTH_CHECK
+  void pollHealth();
+#endif
+  uint32_t measureTime();
+#if CAP1188_SAMPLE_RING
+  void recordSample(uint8_t status, uint8_t touched);
+#endif
+#if CAP1188_LATENCY
+  void recordLatency(uint8_t touched, uint32_t readStart);
+#endif
+#if CAP1188_BUS_TRACE
+  bool replaying();
+#else
+  bool replaying() { return false; } ///< Register traffic goes to the bus
+#endif
+  bool hasBus();
+#if CAP1188_BUS_STATS
+  void countTransaction(uint16_t bytes, uint8_t conditions);
+#endif
+
   Adafruit_I2CDevice *i2c_dev = NULL; ///< Pointer to I2C bus interface
   Adafruit_SPIDevice *spi_dev = NULL; ///< Pointer to SPI bus interface
   int8_t _resetpin;
+  uint8_t _calPending = 0; ///< Inputs whose calibration has not completed
+  uint8_t _config[CAP1188_CONFIG_SIZE] = {0}; ///< Configuration registers as
+                                              ///< last written or read
+#if CAP1188_NOISE_EVENTS
+  uint16_t _noiseEvents[8] = {0}; ///< Rising edges of each noise flag
+  uint8_t _noiseFlags = 0;        ///< Noise Flag Status last read
+#endif
+#if CAP1188_SAMPLE_RING
+  Adafruit_CAP1188_SampleRing *_ring = NULL; ///< Optional sample capture
+#endif
+#if CAP1188_BUS_TRACE
+  Adafruit_CAP1188_BusTrace *_trace = NULL; ///< Optional register trace
+#endif
+#if CAP1188_BUS_STATS
+  cap1188_bus_stats_t _stats = {0, 0, 0}; ///< Traffic since reset
+#endif
+#if CAP1188_LATENCY
+  Adafruit_CAP1188_Latency *_latency = NULL; ///< Optional latency histogram
+  volatile uint32_t _edgeTime = 0;    ///< micros() of the unserved ALERT edge
+  volatile bool _edgePending = false; ///< An ALERT edge awaits a read
+  uint8_t _deliveredTouched = 0;      ///< Touch status last returned
+#endif
+  bool _intDriven = false; ///< touched() only reads status on an interrupt
+  bool _intOnRelease = true;  ///< Releases assert the interrupt
+  int8_t _alertPin = -1;      ///< ALERT input, -1 if not connected
+  uint8_t _touchState = 0;    ///< Touch status as of the last interrupt
+  int16_t _addrPtr = -1; ///< Register the sensor's address pointer is known
+                         ///< to be on, -1 if unknown
+  uint8_t _ledOutput = 0;       ///< LED Output Control, possibly not written
+  bool _ledOutputDirty = false; ///< _ledOutput not yet written
+#if CAP1188_HEALTH_CHECK
+  uint16_t _healthInterval = 0; ///< Polls between health checks, 0 for none
+  uint16_t _healthPolls = 0;    ///< Polls since the last health check
+  uint16_t _resets = 0;         ///< Unexpected resets detected
+#endif
+  bool _warmStart = false;   ///< begin() may keep a configured sensor
+  bool _warmStarted = false; ///< begin() kept the sensor's configuration
+#if CAP1188_STORED_CONFIG
+  Adafruit_CAP1188_Storage *_storage = NULL; ///< Optional profile storage
+  bool _storedConfig = false; ///< begin() applied the stored profile
+#endif
+#if CAP1188_FRAME_CACHE
+  bool _frameCache = false;  ///< touched() reuses results within a cycle
+  bool _frameValid = false;  ///< _frameTouched may be reused
+  bool _alertLow = false;    ///< ALERT was asserted when last sampled
+  uint8_t _frameTouched = 0; ///< Result of the last touched() read
+  uint32_t _frameTime = 0;   ///< micros() of the last touched() read
+  uint32_t _framePeriod = 0; ///< Cycle time when it was read
+#endif
 };
+
+#endif
@@ -0,0 +1,147 @@
+/*!
+ *  @file Adafruit_CAP1188_BusTrace.cpp
+ *
+ *  Register trace recording and replay for the CAP1188 8-Channel Capacitive
+ *  Sensor
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_CAP1188_BusTrace.h"
+#include <string.h>
+
+/*!
+ *    @brief  Instantiates a trace over caller-provided storage, ready to
+ *            record
+ *    @param  buffer
+ *            trace storage
+ *    @param  size
+ *            bytes available at buffer
+ */
+Adafruit_CAP1188_BusTrace::Adafruit_CAP1188_BusTrace(uint8_t *buffer,
+                                                     size_t size) {
+  _buffer = buffer;
+  _size = size;
+}
+
+/*!
+ *    @brief  Clears the trace and starts recording
+ */
+void Adafruit_CAP1188_BusTrace::record() {
+  _replaying = false;
+  _overflowed = false;
+  _started = false;
+  _length = 0;
+  _pos = 0;
+}
+
+/*!
+ *    @brief  Starts replaying a trace already in the buffer. The driver then
+ *            takes read data from the trace and checks its writes against
+ *            it instead of using the bus.
+ *    @param  length
+ *            bytes of trace in the buffer
+ */
+void Adafruit_CAP1188_BusTrace::replay(size_t length) {
+  _length = length > _size ? _size : length;
+  _replaying = true;
+  rewind();
+}
+
+/*!
+ *    @brief  Restarts the replay from the first transaction
+ */
+void Adafruit_CAP1188_BusTrace::rewind() {
+  _pos = 0;
+  _mismatches = 0;
+}
+
+/*!
+ *    @brief  Gets the data length of the next transaction to replay
+ *    @return Number of data bytes, 0 if the trace is finished
+ */
+uint8_t Adafruit_CAP1188_BusTrace::pending() const {
+  if (_pos + CAP1188_TRACE_ENTRY_HEADER > _length) {
+    return 0;
+  }
+  return _buffer[_pos + 2];
+}
+
+/*!
+ *    @brief  Appends a transaction. Called by the driver while recording.
+ *    @param  op
+ *            CAP1188_TRACE_READ, CAP1188_TRACE_READ_CURRENT or
+ *            CAP1188_TRACE_WRITE, optionally with CAP1188_TRACE_FAILED
+ *    @param  reg
+ *            first register
+ *    @param  data
+ *            bytes written or read
+ *    @param  len
+ *            number of bytes
+ *    @param  now
+ *            current time in microseconds
+ */
+void Adafruit_CAP1188_BusTrace::log(uint8_t op, uint8_t reg,
+                                    const uint8_t *data, uint8_t len,
+                                    uint32_t now) {
+  if (_replaying || _overflowed) {
+    return;
+  }
+  if (_length + CAP1188_TRACE_ENTRY_HEADER + len > _size) {
+    _overflowed = true;
+    return;
+  }
+  uint32_t dt = _started ? now - _lastTime : 0;
+  if (dt > 0xFFFF)
+    dt = 0xFFFF;
+  _started = true;
+  _lastTime = now;
+
+  uint8_t *p = _buffer + _length;
+  p[0] = op;
+  p[1] = reg;
+  p[2] = len;
+  p[3] = dt & 0xFF;
+  p[4] = dt >> 8;
+  memcpy(p + CAP1188_TRACE_ENTRY_HEADER, data, len);
+  _length += CAP1188_TRACE_ENTRY_HEADER + len;
+}
+
+/*!
+ *    @brief  Plays back the next transaction. Called by the driver while
+ *            replaying.
+ *    @param  op
+ *            CAP1188_TRACE_READ, CAP1188_TRACE_READ_CURRENT or
+ *            CAP1188_TRACE_WRITE
+ *    @param  reg
+ *            first register
+ *    @param  data
+ *            filled with the recorded data for a read, compared with the
+ *            recorded data for a write
+ *    @param  len
+ *            number of bytes
+ *    @return The recorded outcome of the transaction; false if the driver
+ *            diverged from the trace, which is also counted in mismatches()
+ */
+bool Adafruit_CAP1188_BusTrace::play(uint8_t op, uint8_t reg, uint8_t *data,
+                                     uint8_t len) {
+  if (_pos + CAP1188_TRACE_ENTRY_HEADER > _length) {
+    _mismatches++;
+    return false;
+  }
+  const uint8_t *p = _buffer + _pos;
+  if ((p[0] & ~CAP1188_TRACE_FAILED) != op || p[1] != reg || p[2] != len ||
+      _pos + CAP1188_TRACE_ENTRY_HEADER + len > _length) {
+    // Leave the entry in place, the driver may resync with it
+    _mismatches++;
+    return false;
+  }
+  const uint8_t *recorded = p + CAP1188_TRACE_ENTRY_HEADER;
+  if (op != CAP1188_TRACE_WRITE) {
+    memcpy(data, recorded, len);
+  } else if (memcmp(data, recorded, len)) {
+    _mismatches++;
+  }
+  _pos += CAP1188_TRACE_ENTRY_HEADER + len;
+  return !(p[0] & CAP1188_TRACE_FAILED);
+}
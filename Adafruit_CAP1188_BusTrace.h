@@ -0,0 +1,65 @@
+/*!
+ *  @file Adafruit_CAP1188_BusTrace.h
+ *
+ *  Register trace recording and replay for the CAP1188 8-Channel Capacitive
+ *  Sensor
+ *
+ *  Each transaction is stored as an op byte, the register, the number of
+ *  data bytes, the microseconds since the previous transaction as a
+ *  saturating little-endian uint16_t, and the data bytes written or read.
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef ADAFRUIT_CAP1188_BUSTRACE_H
+#define ADAFRUIT_CAP1188_BUSTRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define CAP1188_TRACE_READ 0x01   ///< Op: register read
+#define CAP1188_TRACE_WRITE 0x02  ///< Op: register write
+#define CAP1188_TRACE_READ_CURRENT                                             \
+  0x03 ///< Op: read from the current address pointer, without an address
+       ///< phase
+#define CAP1188_TRACE_FAILED 0x80 ///< Op flag: the transaction failed
+
+#define CAP1188_TRACE_ENTRY_HEADER 5 ///< Bytes stored before the data
+
+/*!
+ *    @brief  Records the register traffic of an Adafruit_CAP1188 into a
+ *            caller-provided buffer, or feeds a recorded trace back to it
+ *            in place of the bus
+ */
+class Adafruit_CAP1188_BusTrace {
+public:
+  Adafruit_CAP1188_BusTrace(uint8_t *buffer, size_t size);
+
+  void record();
+  void replay(size_t length);
+  void rewind();
+
+  bool replaying() const { return _replaying; } ///< Feeding the driver
+  size_t length() const { return _length; }     ///< Bytes recorded
+  bool overflowed() const { return _overflowed; } ///< Recording was cut off
+  uint16_t mismatches() const { return _mismatches; } ///< Replay divergences
+  bool finished() const { return _pos >= _length; }   ///< Replay consumed
+  uint8_t pending() const;
+
+  void log(uint8_t op, uint8_t reg, const uint8_t *data, uint8_t len,
+           uint32_t now);
+  bool play(uint8_t op, uint8_t reg, uint8_t *data, uint8_t len);
+
+private:
+  uint8_t *_buffer;
+  size_t _size;
+  size_t _length = 0;
+  size_t _pos = 0;
+  uint32_t _lastTime = 0;
+  bool _started = false;
+  bool _replaying = false;
+  bool _overflowed = false;
+  uint16_t _mismatches = 0;
+};
+
+#endif
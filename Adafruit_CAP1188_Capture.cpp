@@ -0,0 +1,261 @@
+/*!
+ *  @file Adafruit_CAP1188_Capture.cpp
+ *
+ *  Compact binary capture format for CAP1188 8-Channel Capacitive Sensor
+ *  frames
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_CAP1188_Capture.h"
+#include <string.h>
+
+/*!
+ *    @brief  First bytes of every capture, followed by the format version
+ */
+static const uint8_t magic[5] = {'C', '1', '1', '8', '8'};
+
+/*!
+ *    @brief  Writes a little-endian base-128 varint, 7 bits per byte with the
+ *            high bit set on every byte but the last
+ *    @param  p
+ *            destination, room for up to 5 bytes
+ *    @param  v
+ *            value to write
+ *    @return Bytes written
+ */
+static uint8_t putVarint(uint8_t *p, uint32_t v) {
+  uint8_t n = 0;
+  while (v >= 0x80) {
+    p[n++] = (v & 0x7F) | 0x80;
+    v >>= 7;
+  }
+  p[n++] = v;
+  return n;
+}
+
+/*!
+ *    @brief  Reads a varint written by putVarint()
+ *    @param  p
+ *            start of the varint
+ *    @param  len
+ *            bytes available at p
+ *    @param  v
+ *            set to the value read
+ *    @return Bytes consumed, 0 if the varint is truncated or longer than 5
+ *            bytes
+ */
+static size_t getVarint(const uint8_t *p, size_t len, uint32_t *v) {
+  uint32_t value = 0;
+  for (size_t n = 0; n < len && n < 5; n++) {
+    value |= (uint32_t)(p[n] & 0x7F) << (7 * n);
+    if (!(p[n] & 0x80)) {
+      *v = value;
+      return n + 1;
+    }
+  }
+  return 0;
+}
+
+/*!
+ *    @brief  Instantiates an encoder
+ *    @param  keyInterval
+ *            maximum number of frames between two key frames, 1-255
+ */
+Adafruit_CAP1188_CaptureEncoder::Adafruit_CAP1188_CaptureEncoder(
+    uint8_t keyInterval) {
+  _keyInterval = keyInterval ? keyInterval : 1;
+  reset();
+}
+
+/*!
+ *    @brief  Makes the next frame a key frame
+ */
+void Adafruit_CAP1188_CaptureEncoder::reset() {
+  memset(&_prev, 0, sizeof(_prev));
+  _sinceKey = _keyInterval;
+}
+
+/*!
+ *    @brief  Writes the capture header and restarts the encoding
+ *    @param  buffer
+ *            destination
+ *    @param  size
+ *            space available at buffer
+ *    @return Bytes written, 0 if there was not enough space
+ */
+size_t Adafruit_CAP1188_CaptureEncoder::header(uint8_t *buffer, size_t size) {
+  if (size < CAP1188_CAPTURE_HEADER_SIZE) {
+    return 0;
+  }
+  memcpy(buffer, magic, sizeof(magic));
+  buffer[5] = CAP1188_CAPTURE_VERSION;
+  reset();
+  return CAP1188_CAPTURE_HEADER_SIZE;
+}
+
+/*!
+ *    @brief  Encodes one frame
+ *    @param  frame
+ *            frame to encode
+ *    @param  buffer
+ *            destination
+ *    @param  size
+ *            space available at buffer
+ *    @return Bytes written, 0 if there was not enough space. Nothing is
+ *            written unless the whole frame fits.
+ */
+size_t Adafruit_CAP1188_CaptureEncoder::encode(const cap1188_frame_t *frame,
+                                               uint8_t *buffer, size_t size) {
+  uint8_t out[CAP1188_CAPTURE_MAX_FRAME];
+  bool key = _sinceKey >= _keyInterval;
+  uint8_t flags = key ? (CAP1188_CAPTURE_KEY | CAP1188_CAPTURE_STATUS |
+                         CAP1188_CAPTURE_NOISE | CAP1188_CAPTURE_TOUCHED)
+                      : 0;
+  if (frame->status != _prev.status)
+    flags |= CAP1188_CAPTURE_STATUS;
+  if (frame->noise != _prev.noise)
+    flags |= CAP1188_CAPTURE_NOISE;
+  if (frame->touched != _prev.touched)
+    flags |= CAP1188_CAPTURE_TOUCHED;
+
+  uint8_t changed = 0;
+  for (uint8_t i = 0; i < 8; i++) {
+    if (key || frame->deltas[i] != _prev.deltas[i])
+      changed |= 1 << i;
+  }
+  if (changed)
+    flags |= CAP1188_CAPTURE_DELTAS;
+
+  uint8_t n = 0;
+  out[n++] = flags;
+  n += putVarint(out + n, key ? frame->time : frame->time - _prev.time);
+  if (flags & CAP1188_CAPTURE_STATUS)
+    out[n++] = frame->status;
+  if (flags & CAP1188_CAPTURE_NOISE)
+    out[n++] = frame->noise;
+  if (flags & CAP1188_CAPTURE_TOUCHED)
+    out[n++] = frame->touched;
+  if (changed) {
+    out[n++] = changed;
+    for (uint8_t i = 0; i < 8; i++) {
+      if (!(changed & (1 << i)))
+        continue;
+      int16_t diff = frame->deltas[i] - (key ? 0 : _prev.deltas[i]);
+      // Shifted unsigned, as shifting a negative value left is undefined
+      uint16_t zigzag = ((uint16_t)diff << 1) ^ (uint16_t)(diff >> 15);
+      n += putVarint(out + n, zigzag);
+    }
+  }
+
+  if (n > size) {
+    return 0;
+  }
+  memcpy(buffer, out, n);
+  _prev = *frame;
+  _sinceKey = key ? 1 : _sinceKey + 1;
+  return n;
+}
+
+/*!
+ *    @brief  Instantiates a decoder. Frames are skipped until the first key
+ *            frame.
+ */
+Adafruit_CAP1188_CaptureDecoder::Adafruit_CAP1188_CaptureDecoder() {
+  memset(&_prev, 0, sizeof(_prev));
+  _synced = false;
+}
+
+/*!
+ *    @brief  Checks the capture header
+ *    @param  buffer
+ *            start of the capture
+ *    @param  len
+ *            bytes available at buffer
+ *    @return Header size, 0 if it is not a capture of a supported version
+ */
+size_t Adafruit_CAP1188_CaptureDecoder::header(const uint8_t *buffer,
+                                               size_t len) {
+  if (len < CAP1188_CAPTURE_HEADER_SIZE ||
+      memcmp(buffer, magic, sizeof(magic)) ||
+      buffer[5] != CAP1188_CAPTURE_VERSION) {
+    return 0;
+  }
+  _synced = false;
+  return CAP1188_CAPTURE_HEADER_SIZE;
+}
+
+/*!
+ *    @brief  Decodes the next frame
+ *    @param  buffer
+ *            start of the frame
+ *    @param  len
+ *            bytes available at buffer
+ *    @param  frame
+ *            filled with the decoded frame
+ *    @return Bytes consumed, 0 if the frame is truncated or malformed.
+ *            Frames before the first key frame are consumed without filling
+ *            frame, see synced().
+ */
+size_t Adafruit_CAP1188_CaptureDecoder::decode(const uint8_t *buffer,
+                                               size_t len,
+                                               cap1188_frame_t *frame) {
+  if (!len) {
+    return 0;
+  }
+  uint8_t flags = buffer[0];
+  size_t n = 1;
+  uint32_t dt;
+  size_t used = getVarint(buffer + n, len - n, &dt);
+  if (!used) {
+    return 0;
+  }
+  n += used;
+
+  cap1188_frame_t f = _prev;
+  bool key = flags & CAP1188_CAPTURE_KEY;
+  if (key) {
+    memset(&f, 0, sizeof(f));
+  }
+  f.time = key ? dt : _prev.time + dt;
+  if (flags & CAP1188_CAPTURE_STATUS) {
+    if (n >= len)
+      return 0;
+    f.status = buffer[n++];
+  }
+  if (flags & CAP1188_CAPTURE_NOISE) {
+    if (n >= len)
+      return 0;
+    f.noise = buffer[n++];
+  }
+  if (flags & CAP1188_CAPTURE_TOUCHED) {
+    if (n >= len)
+      return 0;
+    f.touched = buffer[n++];
+  }
+  if (flags & CAP1188_CAPTURE_DELTAS) {
+    if (n >= len)
+      return 0;
+    uint8_t changed = buffer[n++];
+    for (uint8_t i = 0; i < 8; i++) {
+      if (!(changed & (1 << i)))
+        continue;
+      uint32_t z;
+      used = getVarint(buffer + n, len - n, &z);
+      if (!used)
+        return 0;
+      n += used;
+      int16_t diff = (int16_t)(z >> 1) ^ -(int16_t)(z & 1);
+      f.deltas[i] = f.deltas[i] + diff;
+    }
+  }
+
+  if (key) {
+    _synced = true;
+  }
+  if (_synced) {
+    _prev = f;
+    *frame = f;
+  }
+  return n;
+}
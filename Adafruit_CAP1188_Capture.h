@@ -0,0 +1,78 @@
+/*!
+ *  @file Adafruit_CAP1188_Capture.h
+ *
+ *  Compact binary capture format for CAP1188 8-Channel Capacitive Sensor
+ *  frames
+ *
+ *  A capture starts with a 6 byte header: "C1188" followed by the format
+ *  version. Each frame then starts with a flags byte and the time since the
+ *  previous frame in microseconds as a little-endian base-128 varint,
+ *  followed by the status, noise and touched bytes if they changed, and the
+ *  delta counts that changed as a change mask byte plus one zigzag varint
+ *  difference per changed input. Key frames carry every field and reset the
+ *  differences; one is emitted at least every keyInterval frames.
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef ADAFRUIT_CAP1188_CAPTURE_H
+#define ADAFRUIT_CAP1188_CAPTURE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define CAP1188_CAPTURE_VERSION 1      ///< Format version in the header
+#define CAP1188_CAPTURE_HEADER_SIZE 6  ///< Bytes written by header()
+#define CAP1188_CAPTURE_MAX_FRAME 26   ///< Largest encoded frame in bytes
+
+#define CAP1188_CAPTURE_KEY 0x01     ///< Frame flag: key frame
+#define CAP1188_CAPTURE_STATUS 0x02  ///< Frame flag: status byte present
+#define CAP1188_CAPTURE_NOISE 0x04   ///< Frame flag: noise byte present
+#define CAP1188_CAPTURE_TOUCHED 0x08 ///< Frame flag: touched byte present
+#define CAP1188_CAPTURE_DELTAS 0x10  ///< Frame flag: delta changes present
+
+/*!
+ *    @brief  One captured sensor frame
+ */
+typedef struct {
+  uint32_t time;     ///< Timestamp in microseconds
+  uint8_t status;    ///< General Status
+  uint8_t noise;     ///< Noise Flag Status
+  uint8_t touched;   ///< Sensor Input Status
+  int8_t deltas[8];  ///< Delta counts of the eight inputs
+} cap1188_frame_t;
+
+/*!
+ *    @brief  Encodes frames into a caller-provided buffer
+ */
+class Adafruit_CAP1188_CaptureEncoder {
+public:
+  Adafruit_CAP1188_CaptureEncoder(uint8_t keyInterval = 64);
+
+  size_t header(uint8_t *buffer, size_t size);
+  size_t encode(const cap1188_frame_t *frame, uint8_t *buffer, size_t size);
+  void reset();
+
+private:
+  cap1188_frame_t _prev;
+  uint8_t _keyInterval;
+  uint8_t _sinceKey;
+};
+
+/*!
+ *    @brief  Decodes frames written by Adafruit_CAP1188_CaptureEncoder
+ */
+class Adafruit_CAP1188_CaptureDecoder {
+public:
+  Adafruit_CAP1188_CaptureDecoder();
+
+  size_t header(const uint8_t *buffer, size_t len);
+  size_t decode(const uint8_t *buffer, size_t len, cap1188_frame_t *frame);
+  bool synced() const { return _synced; } ///< A key frame has been decoded
+
+private:
+  cap1188_frame_t _prev;
+  bool _synced;
+};
+
+#endif
@@ -0,0 +1,42 @@
+/*!
+ *  @file Adafruit_CAP1188_Config.h
+ *
+ *  Optional features of the CAP1188 8-Channel Capacitive Sensor driver
+ *
+ *  A feature that is off adds no code, state or bus traffic to the driver.
+ *  Set one to 1 here, or with a build flag such as -DCAP1188_SAMPLE_RING=1
+ *  that reaches the library as well as the sketch. A #define in the sketch
+ *  is not seen when the library is compiled.
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef ADAFRUIT_CAP1188_CONFIG_H
+#define ADAFRUIT_CAP1188_CONFIG_H
+
+#ifndef CAP1188_SAMPLE_RING
+#define CAP1188_SAMPLE_RING 0 ///< setSampleRing()
+#endif
+#ifndef CAP1188_BUS_TRACE
+#define CAP1188_BUS_TRACE 0 ///< setBusTrace()
+#endif
+#ifndef CAP1188_BUS_STATS
+#define CAP1188_BUS_STATS 0 ///< getBusStats()
+#endif
+#ifndef CAP1188_HEALTH_CHECK
+#define CAP1188_HEALTH_CHECK 0 ///< checkHealth() and setHealthCheck()
+#endif
+#ifndef CAP1188_STORED_CONFIG
+#define CAP1188_STORED_CONFIG 0 ///< setStorage() and saveConfig()
+#endif
+#ifndef CAP1188_FRAME_CACHE
+#define CAP1188_FRAME_CACHE 0 ///< setFrameCache()
+#endif
+#ifndef CAP1188_LATENCY
+#define CAP1188_LATENCY 0 ///< setLatencyHistogram() and alertEdge()
+#endif
+#ifndef CAP1188_NOISE_EVENTS
+#define CAP1188_NOISE_EVENTS 0 ///< noiseEvents()
+#endif
+
+#endif
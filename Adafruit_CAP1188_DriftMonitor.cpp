@@ -0,0 +1,158 @@
+/*!
+ *  @file Adafruit_CAP1188_DriftMonitor.cpp
+ *
+ *  Base count drift monitor for the CAP1188 8-Channel Capacitive Sensor.
+ *  Each update is a fixed amount of integer work per input and nothing is
+ *  allocated.
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_CAP1188_DriftMonitor.h"
+
+/*!
+ *    @brief  Instantiates a new drift monitor
+ *    @param  band
+ *            allowed distance of the average from the reference base count
+ *    @param  smoothing
+ *            moving average weight of a new sample is 1/2^smoothing
+ */
+Adafruit_CAP1188_DriftMonitor::Adafruit_CAP1188_DriftMonitor(
+    uint8_t band, uint8_t smoothing) {
+  _band = band;
+  setSmoothing(smoothing);
+}
+
+/*!
+ *    @brief  Forgets the history of the selected inputs; their next sample
+ *            becomes the new reference
+ *    @param  channelMask
+ *            inputs to reset, bit 0 is input 1
+ */
+void Adafruit_CAP1188_DriftMonitor::reset(uint8_t channelMask) {
+  _primed &= ~channelMask;
+  _drifting &= ~channelMask;
+}
+
+/*!
+ *    @brief  Sets the allowed distance of the average from the reference
+ *    @param  band
+ *            allowed distance in base count units
+ */
+void Adafruit_CAP1188_DriftMonitor::setBand(uint8_t band) { _band = band; }
+
+/*!
+ *    @brief  Sets the moving average weight
+ *    @param  smoothing
+ *            weight of a new sample is 1/2^smoothing, 0-8
+ */
+void Adafruit_CAP1188_DriftMonitor::setSmoothing(uint8_t smoothing) {
+  _smoothing = smoothing > 8 ? 8 : smoothing;
+}
+
+/*!
+ *    @brief  Feeds one set of base counts into the monitor
+ *    @param  counts
+ *            base count of each input, as from readBaseCounts()
+ *    @param  channelMask
+ *            inputs to update, others are left untouched
+ *    @return Mask of inputs whose average is outside the band
+ */
+uint8_t Adafruit_CAP1188_DriftMonitor::update(const uint8_t counts[8],
+                                              uint8_t channelMask) {
+  for (uint8_t i = 0; i < 8; i++) {
+    uint8_t bit = 1 << i;
+    if (!(channelMask & bit))
+      continue;
+    uint8_t c = counts[i];
+    if (!(_primed & bit)) {
+      _avg[i] = (uint16_t)c << 8;
+      _ref[i] = _min[i] = _max[i] = c;
+      _primed |= bit;
+      continue;
+    }
+    int32_t step = ((int32_t)c << 8) - _avg[i];
+    _avg[i] += step >> _smoothing;
+    if (c < _min[i])
+      _min[i] = c;
+    if (c > _max[i])
+      _max[i] = c;
+
+    int16_t dist = (int16_t)(_avg[i] >> 8) - _ref[i];
+    if (dist < 0)
+      dist = -dist;
+    if (dist > _band) {
+      _drifting |= bit;
+    } else {
+      _drifting &= ~bit;
+    }
+  }
+  return _drifting;
+}
+
+/*!
+ *    @brief  Reads the base counts from the sensor in one burst and feeds
+ *            those of the enabled inputs into the monitor
+ *    @param  cap
+ *            sensor to sample
+ *    @param  recalibrate
+ *            if true, drifting inputs are recalibrated and re-referenced
+ *    @return Mask of inputs whose average is outside the band, before any
+ *            recalibration
+ */
+uint8_t Adafruit_CAP1188_DriftMonitor::sample(Adafruit_CAP1188 &cap,
+                                              bool recalibrate) {
+  // Base counts are meaningless while a calibration is running
+  if (!cap.calibrationDone()) {
+    return _drifting;
+  }
+  uint8_t counts[8];
+  if (!cap.readBaseCounts(counts)) {
+    return _drifting;
+  }
+  uint8_t drift = update(counts, cap.getInputEnable());
+  if (recalibrate && drift && cap.calibrate(drift)) {
+    reset(drift);
+  }
+  return drift;
+}
+
+/*!
+ *    @brief  Gets the moving average of an input's base count
+ *    @param  channel
+ *            input, 0-7
+ *    @return Integer part of the moving average
+ */
+uint8_t Adafruit_CAP1188_DriftMonitor::average(uint8_t channel) const {
+  return _avg[channel & 7] >> 8;
+}
+
+/*!
+ *    @brief  Gets the base count an input is compared against
+ *    @param  channel
+ *            input, 0-7
+ *    @return First base count seen since the input was last reset
+ */
+uint8_t Adafruit_CAP1188_DriftMonitor::reference(uint8_t channel) const {
+  return _ref[channel & 7];
+}
+
+/*!
+ *    @brief  Gets the smallest base count seen since the input was reset
+ *    @param  channel
+ *            input, 0-7
+ *    @return Minimum base count
+ */
+uint8_t Adafruit_CAP1188_DriftMonitor::minimum(uint8_t channel) const {
+  return _min[channel & 7];
+}
+
+/*!
+ *    @brief  Gets the largest base count seen since the input was reset
+ *    @param  channel
+ *            input, 0-7
+ *    @return Maximum base count
+ */
+uint8_t Adafruit_CAP1188_DriftMonitor::maximum(uint8_t channel) const {
+  return _max[channel & 7];
+}
@@ -0,0 +1,47 @@
+/*!
+ *  @file Adafruit_CAP1188_DriftMonitor.h
+ *
+ *  Base count drift monitor for the CAP1188 8-Channel Capacitive Sensor
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef ADAFRUIT_CAP1188_DRIFTMONITOR_H
+#define ADAFRUIT_CAP1188_DRIFTMONITOR_H
+
+#include "Adafruit_CAP1188.h"
+
+/*!
+ *    @brief  Tracks a fixed-point moving average and the min/max of each
+ *            input's base count, and flags inputs whose average moves
+ *            further than a band from the value seen after calibration
+ */
+class Adafruit_CAP1188_DriftMonitor {
+public:
+  Adafruit_CAP1188_DriftMonitor(uint8_t band = 16, uint8_t smoothing = 3);
+
+  void reset(uint8_t channelMask = 0xFF);
+  void setBand(uint8_t band);
+  void setSmoothing(uint8_t smoothing);
+
+  uint8_t update(const uint8_t counts[8], uint8_t channelMask = 0xFF);
+  uint8_t sample(Adafruit_CAP1188 &cap, bool recalibrate = false);
+
+  uint8_t drifting() const { return _drifting; } ///< Mask of drifting inputs
+  uint8_t average(uint8_t channel) const;
+  uint8_t reference(uint8_t channel) const;
+  uint8_t minimum(uint8_t channel) const;
+  uint8_t maximum(uint8_t channel) const;
+
+private:
+  uint16_t _avg[8]; ///< Moving average of each base count, 8.8 fixed point
+  uint8_t _ref[8];  ///< Base count when the input was (re)primed
+  uint8_t _min[8];
+  uint8_t _max[8];
+  uint8_t _primed = 0;   ///< Inputs that have seen their first sample
+  uint8_t _drifting = 0; ///< Inputs outside the band
+  uint8_t _band;
+  uint8_t _smoothing;
+};
+
+#endif
@@ -0,0 +1,96 @@
+/*!
+ *  @file Adafruit_CAP1188_Dump.cpp
+ *
+ *  Register dump format for the CAP1188 8-Channel Capacitive Sensor
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_CAP1188_Dump.h"
+
+static const uint8_t magic[2] = {'C', 'R'};
+
+/*!
+ *    @brief  Documented registers, each range read in a single burst
+ */
+const cap1188_dump_range_t
+    Adafruit_CAP1188_Dump::ranges[CAP1188_DUMP_RANGES] = {
+        {0x00, 11}, // Main Control through Noise Flag Status
+        {0x10, 53}, // Delta Counts through Configuration 2
+        {0x50, 8},  // Base Counts
+        {0x71, 37}, // LED Output Type through LED Off Delay
+        {0xFD, 3},  // Product ID, Manufacturer ID and Revision
+};
+
+/*!
+ *    @brief  Writes the header and CRC around the registers of a dump
+ *    @param  dump
+ *            CAP1188_DUMP_SIZE bytes, with the registers filled in at their
+ *            offset()
+ */
+void Adafruit_CAP1188_Dump::seal(uint8_t *dump) {
+  dump[0] = magic[0];
+  dump[1] = magic[1];
+  dump[2] = CAP1188_DUMP_VERSION;
+  dump[3] = CAP1188_DUMP_REGISTERS;
+  uint16_t crc = crc16(dump, CAP1188_DUMP_SIZE - 2);
+  dump[CAP1188_DUMP_SIZE - 2] = crc & 0xFF;
+  dump[CAP1188_DUMP_SIZE - 1] = crc >> 8;
+}
+
+/*!
+ *    @brief  Checks the header and CRC of a dump
+ *    @param  dump
+ *            the dump
+ *    @param  len
+ *            bytes available at dump
+ *    @return True if the dump is complete, of this version and intact
+ */
+bool Adafruit_CAP1188_Dump::valid(const uint8_t *dump, size_t len) {
+  if (len < CAP1188_DUMP_SIZE || dump[0] != magic[0] || dump[1] != magic[1] ||
+      dump[2] != CAP1188_DUMP_VERSION || dump[3] != CAP1188_DUMP_REGISTERS) {
+    return false;
+  }
+  uint16_t crc = crc16(dump, CAP1188_DUMP_SIZE - 2);
+  return dump[CAP1188_DUMP_SIZE - 2] == (crc & 0xFF) &&
+         dump[CAP1188_DUMP_SIZE - 1] == (crc >> 8);
+}
+
+/*!
+ *    @brief  Finds a register in a dump
+ *    @param  reg
+ *            register address
+ *    @return Offset of the register from the start of the dump, -1 if the
+ *            register is not dumped
+ */
+int16_t Adafruit_CAP1188_Dump::offset(uint8_t reg) {
+  int16_t offset = CAP1188_DUMP_HEADER_SIZE;
+  for (uint8_t r = 0; r < CAP1188_DUMP_RANGES; r++) {
+    uint8_t index = reg - ranges[r].reg;
+    if (reg >= ranges[r].reg && index < ranges[r].len) {
+      return offset + index;
+    }
+    offset += ranges[r].len;
+  }
+  return -1;
+}
+
+/*!
+ *    @brief  Computes a CRC-16/CCITT (polynomial 0x1021, initial value
+ *            0xFFFF)
+ *    @param  data
+ *            bytes to check
+ *    @param  len
+ *            number of bytes
+ *    @return The CRC
+ */
+uint16_t Adafruit_CAP1188_Dump::crc16(const uint8_t *data, size_t len) {
+  uint16_t crc = 0xFFFF;
+  while (len--) {
+    crc ^= (uint16_t)*data++ << 8;
+    for (uint8_t i = 0; i < 8; i++) {
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+  }
+  return crc;
+}
@@ -0,0 +1,48 @@
+/*!
+ *  @file Adafruit_CAP1188_Dump.h
+ *
+ *  Register dump format for the CAP1188 8-Channel Capacitive Sensor
+ *
+ *  A dump starts with a 4 byte header: "CR", the format version and the
+ *  number of registers that follow. The registers of each documented range
+ *  follow in address order, and a CRC-16/CCITT of the header and registers
+ *  closes the dump, least significant byte first.
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef ADAFRUIT_CAP1188_DUMP_H
+#define ADAFRUIT_CAP1188_DUMP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define CAP1188_DUMP_VERSION 1     ///< Format version in the header
+#define CAP1188_DUMP_HEADER_SIZE 4 ///< Bytes before the first register
+#define CAP1188_DUMP_REGISTERS 112 ///< Registers in a dump
+#define CAP1188_DUMP_RANGES 5      ///< Ranges of consecutive registers
+#define CAP1188_DUMP_SIZE                                                      \
+  (CAP1188_DUMP_HEADER_SIZE + CAP1188_DUMP_REGISTERS + 2) ///< Bytes in a dump
+
+/*!
+ *    @brief  A range of consecutive registers in a dump
+ */
+typedef struct {
+  uint8_t reg; ///< First register of the range
+  uint8_t len; ///< Number of registers in the range
+} cap1188_dump_range_t;
+
+/*!
+ *    @brief  Layout, sealing and checking of register dumps
+ */
+class Adafruit_CAP1188_Dump {
+public:
+  static const cap1188_dump_range_t ranges[CAP1188_DUMP_RANGES];
+
+  static void seal(uint8_t *dump);
+  static bool valid(const uint8_t *dump, size_t len = CAP1188_DUMP_SIZE);
+  static int16_t offset(uint8_t reg);
+  static uint16_t crc16(const uint8_t *data, size_t len);
+};
+
+#endif
@@ -0,0 +1,71 @@
+/*!
+ *  @file Adafruit_CAP1188_EEPROMStorage.h
+ *
+ *  Keeps a CAP1188 configuration profile in the EEPROM, or the emulated
+ *  EEPROM of cores that provide the EEPROM library
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef ADAFRUIT_CAP1188_EEPROMSTORAGE_H
+#define ADAFRUIT_CAP1188_EEPROMSTORAGE_H
+
+#include "Adafruit_CAP1188_Storage.h"
+#include <EEPROM.h>
+
+/*!
+ *    @brief  Profile storage at a fixed EEPROM address
+ */
+class Adafruit_CAP1188_EEPROMStorage : public Adafruit_CAP1188_Storage {
+public:
+  /*!
+   *    @brief  Instantiates the storage. On cores with emulated EEPROM,
+   *            EEPROM.begin() must have been called with a size that covers
+   *            the profile.
+   *    @param  address
+   *            first EEPROM byte used, CAP1188_PROFILE_SIZE bytes are taken
+   */
+  Adafruit_CAP1188_EEPROMStorage(uint16_t address = 0) : _address(address) {}
+
+  /*!
+   *    @brief  Reads the profile bytes
+   *    @param  buffer
+   *            destination
+   *    @param  len
+   *            number of bytes to read
+   *    @return True, the profile's CRC tells whether anything was stored
+   */
+  bool read(uint8_t *buffer, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+      buffer[i] = EEPROM.read(_address + i);
+    }
+    return true;
+  }
+
+  /*!
+   *    @brief  Writes the profile bytes, skipping those that are unchanged
+   *            to spare EEPROM write cycles
+   *    @param  buffer
+   *            bytes to store
+   *    @param  len
+   *            number of bytes
+   *    @return True if the bytes were committed
+   */
+  bool write(const uint8_t *buffer, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+      if (EEPROM.read(_address + i) != buffer[i]) {
+        EEPROM.write(_address + i, buffer[i]);
+      }
+    }
+#if defined(ESP8266) || defined(ESP32) || defined(ARDUINO_ARCH_RP2040)
+    return EEPROM.commit();
+#else
+    return true;
+#endif
+  }
+
+private:
+  uint16_t _address;
+};
+
+#endif
@@ -0,0 +1,67 @@
+/*!
+ *  @file Adafruit_CAP1188_FileStorage.h
+ *
+ *  Keeps a CAP1188 configuration profile in a file, on Linux hosts or on
+ *  cores whose C library is backed by a file system
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef ADAFRUIT_CAP1188_FILESTORAGE_H
+#define ADAFRUIT_CAP1188_FILESTORAGE_H
+
+#include "Adafruit_CAP1188_Storage.h"
+#include <stdio.h>
+
+/*!
+ *    @brief  Profile storage in a file of its own
+ */
+class Adafruit_CAP1188_FileStorage : public Adafruit_CAP1188_Storage {
+public:
+  /*!
+   *    @brief  Instantiates the storage
+   *    @param  path
+   *            file holding the profile, must outlive this object
+   */
+  Adafruit_CAP1188_FileStorage(const char *path) : _path(path) {}
+
+  /*!
+   *    @brief  Reads the profile bytes
+   *    @param  buffer
+   *            destination
+   *    @param  len
+   *            number of bytes to read
+   *    @return True if the file holds at least len bytes
+   */
+  bool read(uint8_t *buffer, size_t len) {
+    FILE *f = fopen(_path, "rb");
+    if (!f) {
+      return false;
+    }
+    size_t n = fread(buffer, 1, len, f);
+    fclose(f);
+    return n == len;
+  }
+
+  /*!
+   *    @brief  Replaces the file with the profile bytes
+   *    @param  buffer
+   *            bytes to store
+   *    @param  len
+   *            number of bytes
+   *    @return True if the bytes were written
+   */
+  bool write(const uint8_t *buffer, size_t len) {
+    FILE *f = fopen(_path, "wb");
+    if (!f) {
+      return false;
+    }
+    size_t n = fwrite(buffer, 1, len, f);
+    return fclose(f) == 0 && n == len;
+  }
+
+private:
+  const char *_path;
+};
+
+#endif
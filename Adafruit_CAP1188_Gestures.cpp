@@ -0,0 +1,299 @@
+/*!
+ *  @file Adafruit_CAP1188_Gestures.cpp
+ *
+ *  Tap, double-tap, long-press and swipe recognizer for the CAP1188
+ *  8-Channel Capacitive Sensor
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_CAP1188_Gestures.h"
+
+// States
+#define ST_IDLE 0    ///< Not touched
+#define ST_PRESSED 1 ///< First press
+#define ST_HELD 2    ///< Long press reported, waiting for release
+#define ST_GAP 3     ///< Released after a tap, waiting for a second press
+#define ST_SECOND 4  ///< Second press of a double tap
+#define ST_COUNT 5
+
+// Inputs to the state machine
+#define IN_PRESS 0   ///< Touch started
+#define IN_TAP 1     ///< Released quickly without moving
+#define IN_SWIPE 2   ///< Released after moving
+#define IN_SLOW 3    ///< Released too late for a tap, too early for a hold
+#define IN_TIMEOUT 4 ///< The current state's time limit passed
+#define IN_COUNT 5
+
+/*!  @brief One state machine transition */
+typedef struct {
+  uint8_t next; ///< State to enter
+  uint8_t emit; ///< cap1188_gesture_t to report, swipes resolved later
+} transition_t;
+
+#define T(s, g)                                                                \
+  { s, CAP1188_GESTURE_##g }
+
+static const transition_t transitions[ST_COUNT][IN_COUNT] = {
+    // IN_PRESS, IN_TAP, IN_SWIPE, IN_SLOW, IN_TIMEOUT
+    /* ST_IDLE */
+    {T(ST_PRESSED, NONE), T(ST_IDLE, NONE), T(ST_IDLE, NONE),
+     T(ST_IDLE, NONE), T(ST_IDLE, NONE)},
+    /* ST_PRESSED */
+    {T(ST_PRESSED, NONE), T(ST_GAP, NONE), T(ST_IDLE, SWIPE_UP),
+     T(ST_IDLE, NONE), T(ST_HELD, LONG_PRESS)},
+    /* ST_HELD */
+    {T(ST_HELD, NONE), T(ST_IDLE, NONE), T(ST_IDLE, NONE), T(ST_IDLE, NONE),
+     T(ST_HELD, NONE)},
+    /* ST_GAP */
+    {T(ST_SECOND, NONE), T(ST_GAP, NONE), T(ST_GAP, NONE), T(ST_GAP, NONE),
+     T(ST_IDLE, TAP)},
+    /* ST_SECOND */
+    {T(ST_SECOND, NONE), T(ST_IDLE, DOUBLE_TAP), T(ST_IDLE, DOUBLE_TAP),
+     T(ST_IDLE, DOUBLE_TAP), T(ST_HELD, LONG_PRESS)},
+};
+
+#undef T
+
+/*!
+ *    @brief  Instantiates a gesture recognizer with no groups
+ */
+Adafruit_CAP1188_Gestures::Adafruit_CAP1188_Gestures() {}
+
+/*!
+ *    @brief  Adds a group of inputs recognized from touch bitmasks. Swipes
+ *            run along increasing input numbers.
+ *    @param  channelMask
+ *            inputs in the group, bit 0 is input 1
+ *    @return Group number, or -1 if all groups are in use
+ */
+int8_t Adafruit_CAP1188_Gestures::addGroup(uint8_t channelMask) {
+  if (_groups >= CAP1188_GESTURE_GROUPS || !channelMask) {
+    return -1;
+  }
+  group_t *g = &_group[_groups];
+  g->mask = channelMask;
+  g->state = ST_IDLE;
+  g->since = 0;
+  g->start = g->position = 0;
+  g->timing = _defaults;
+  g->queued = false;
+  return _groups++;
+}
+
+/*!
+ *    @brief  Adds a group fed with positions through updateGroup(), such as
+ *            those of an Adafruit_CAP1188_Slider
+ *    @return Group number, or -1 if all groups are in use
+ */
+int8_t Adafruit_CAP1188_Gestures::addPositionGroup() {
+  int8_t group = addGroup(0xFF);
+  if (group >= 0) {
+    _group[group].mask = 0;
+  }
+  return group;
+}
+
+/*!
+ *    @brief  Sets the gesture time limits
+ *    @param  tapTime
+ *            longest press reported as a tap, in ms (default 250)
+ *    @param  doubleTapGap
+ *            longest gap between the two taps of a double tap, in ms
+ *            (default 300)
+ *    @param  longPressTime
+ *            shortest press reported as a long press, in ms (default 800)
+ *    @param  group
+ *            group to configure, or -1 (default) for all groups, including
+ *            those added later
+ */
+void Adafruit_CAP1188_Gestures::setTiming(uint16_t tapTime,
+                                          uint16_t doubleTapGap,
+                                          uint16_t longPressTime,
+                                          int8_t group) {
+  for (int8_t i = -1; i < (int8_t)_groups; i++) {
+    // -1 stands for the defaults
+    timing_t *t = i < 0 ? &_defaults : &_group[i].timing;
+    if (group < 0 || group == i) {
+      t->tapTime = tapTime;
+      t->doubleTapGap = doubleTapGap;
+      t->longPressTime = longPressTime;
+    }
+  }
+}
+
+/*!
+ *    @brief  Sets how far a touch must move to be a swipe
+ *    @param  distance
+ *            distance in position units, 256 per input (default 512)
+ *    @param  group
+ *            group to configure, or -1 (default) for all groups, including
+ *            those added later
+ */
+void Adafruit_CAP1188_Gestures::setSwipeDistance(uint16_t distance,
+                                                 int8_t group) {
+  for (int8_t i = -1; i < (int8_t)_groups; i++) {
+    timing_t *t = i < 0 ? &_defaults : &_group[i].timing;
+    if (group < 0 || group == i) {
+      t->swipeDistance = distance;
+    }
+  }
+}
+
+/*!
+ *    @brief  Feeds a touch bitmask to all input groups. Every group is
+ *            updated even when events is full; a gesture that does not fit
+ *            is kept, one per group, and reported by a later call.
+ *    @param  touched
+ *            touched inputs, as from Adafruit_CAP1188::touched()
+ *    @param  now
+ *            current time in milliseconds
+ *    @param  events
+ *            filled with the recognized gestures
+ *    @param  maxEvents
+ *            size of events; with two per group no gesture is ever held
+ *            back
+ *    @return Number of gestures written to events
+ */
+uint8_t Adafruit_CAP1188_Gestures::update(uint8_t touched, uint32_t now,
+                                          cap1188_gesture_event_t *events,
+                                          uint8_t maxEvents) {
+  uint8_t count = 0;
+  for (uint8_t i = 0; i < _groups; i++) {
+    group_t *g = &_group[i];
+    if (!g->mask) {
+      continue;
+    }
+    if (g->queued && count < maxEvents) {
+      events[count++] = g->pending;
+      g->queued = false;
+    }
+    uint8_t mask = g->mask;
+    // Position of the touch within the group: the middle of the lowest and
+    // highest touched inputs, 256 units per input of the group
+    uint8_t hits = touched & mask;
+    uint8_t index = 0, low = 0xFF, high = 0;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      if (!(mask & (1 << bit)))
+        continue;
+      if (hits & (1 << bit)) {
+        if (low == 0xFF)
+          low = index;
+        high = index;
+      }
+      index++;
+    }
+    uint16_t position = hits ? (uint16_t)(low + high) * 128 : 0;
+    cap1188_gesture_event_t event;
+    if (updateGroup(i, hits != 0, position, now, &event)) {
+      if (count < maxEvents) {
+        events[count++] = event;
+      } else if (!g->queued) {
+        g->pending = event;
+        g->queued = true;
+      }
+    }
+  }
+  return count;
+}
+
+/*!
+ *    @brief  Feeds one group with its touch state and position
+ *    @param  group
+ *            group number
+ *    @param  touched
+ *            true while the group is touched
+ *    @param  position
+ *            position of the touch, 256 units per input
+ *    @param  now
+ *            current time in milliseconds
+ *    @param  event
+ *            filled with the recognized gesture, if any
+ *    @return True if a gesture was recognized
+ */
+bool Adafruit_CAP1188_Gestures::updateGroup(uint8_t group, bool touched,
+                                            uint16_t position, uint32_t now,
+                                            cap1188_gesture_event_t *event) {
+  if (group >= _groups) {
+    return false;
+  }
+  group_t *g = &_group[group];
+  bool down = g->state == ST_PRESSED || g->state == ST_HELD ||
+              g->state == ST_SECOND;
+  if (touched && down) {
+    g->position = position;
+  }
+
+  // The state's time limit is checked before any touch change, so that an
+  // update that comes late still ends the state the limit ran out in. The
+  // timeout never changes whether the group is down.
+  uint16_t limit = 0;
+  if (g->state == ST_PRESSED || g->state == ST_SECOND) {
+    limit = g->timing.longPressTime;
+  } else if (g->state == ST_GAP) {
+    limit = g->timing.doubleTapGap;
+  }
+  bool timedOut = false;
+  if (limit && now - g->since >= limit) {
+    timedOut = step(group, IN_TIMEOUT, position, now, event);
+  }
+  if (touched == down) {
+    return timedOut;
+  }
+
+  uint8_t input = IN_PRESS;
+  if (!touched) {
+    int32_t travel = (int32_t)g->position - g->start;
+    if (travel >= g->timing.swipeDistance ||
+        -travel >= g->timing.swipeDistance) {
+      input = IN_SWIPE;
+    } else if (now - g->since <= g->timing.tapTime) {
+      input = IN_TAP;
+    } else {
+      input = IN_SLOW;
+    }
+  }
+  // A timeout leaves ST_IDLE or ST_HELD, where a touch change reports
+  // nothing, so at most one of the two steps fills event
+  return step(group, input, position, now, event) || timedOut;
+}
+
+/*!
+ *    @brief  Applies one input to a group's state machine
+ *    @param  group
+ *            group number
+ *    @param  input
+ *            state machine input
+ *    @param  position
+ *            position of the touch, 256 units per input
+ *    @param  now
+ *            current time in milliseconds
+ *    @param  event
+ *            filled with the recognized gesture, if any
+ *    @return True if a gesture was recognized
+ */
+bool Adafruit_CAP1188_Gestures::step(uint8_t group, uint8_t input,
+                                     uint16_t position, uint32_t now,
+                                     cap1188_gesture_event_t *event) {
+  group_t *g = &_group[group];
+  const transition_t *t = &transitions[g->state][input];
+  uint8_t emit = t->emit;
+  if (emit == CAP1188_GESTURE_SWIPE_UP && g->position < g->start) {
+    emit = CAP1188_GESTURE_SWIPE_DOWN;
+  }
+  if (t->next != g->state) {
+    g->since = now;
+  }
+  g->state = t->next;
+  if (input == IN_PRESS && g->state == ST_PRESSED) {
+    g->start = g->position = position;
+  }
+  if (emit == CAP1188_GESTURE_NONE) {
+    return false;
+  }
+  event->gesture = (cap1188_gesture_t)emit;
+  event->group = group;
+  event->position = g->start;
+  event->time = now;
+  return true;
+}
@@ -0,0 +1,89 @@
+/*!
+ *  @file Adafruit_CAP1188_Gestures.h
+ *
+ *  Tap, double-tap, long-press and swipe recognizer for the CAP1188
+ *  8-Channel Capacitive Sensor
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef ADAFRUIT_CAP1188_GESTURES_H
+#define ADAFRUIT_CAP1188_GESTURES_H
+
+#include "Adafruit_CAP1188.h"
+
+#define CAP1188_GESTURE_GROUPS 4 ///< Maximum number of gesture groups
+
+/*!
+ *    @brief  Gestures reported by Adafruit_CAP1188_Gestures
+ */
+typedef enum {
+  CAP1188_GESTURE_NONE = 0,   ///< Nothing recognized
+  CAP1188_GESTURE_TAP,        ///< Short press with no second press
+  CAP1188_GESTURE_DOUBLE_TAP, ///< Two short presses in quick succession
+  CAP1188_GESTURE_LONG_PRESS, ///< Press held past the long press time
+  CAP1188_GESTURE_SWIPE_UP,   ///< Towards higher numbered inputs
+  CAP1188_GESTURE_SWIPE_DOWN, ///< Towards lower numbered inputs
+} cap1188_gesture_t;
+
+/*!
+ *    @brief  A recognized gesture
+ */
+typedef struct {
+  cap1188_gesture_t gesture; ///< What was recognized
+  uint8_t group;             ///< Group it was recognized on
+  uint16_t position;         ///< Where the gesture started
+  uint32_t time;             ///< When the gesture was recognized, in ms
+} cap1188_gesture_event_t;
+
+/*!
+ *    @brief  Recognizes gestures on groups of inputs from timestamped touch
+ *            bitmasks or slider positions. Each group runs a small
+ *            table-driven state machine; nothing is allocated and an update
+ *            costs a fixed amount of work per group.
+ */
+class Adafruit_CAP1188_Gestures {
+public:
+  Adafruit_CAP1188_Gestures();
+
+  int8_t addGroup(uint8_t channelMask);
+  int8_t addPositionGroup();
+  void setTiming(uint16_t tapTime, uint16_t doubleTapGap,
+                 uint16_t longPressTime, int8_t group = -1);
+  void setSwipeDistance(uint16_t distance, int8_t group = -1);
+
+  uint8_t update(uint8_t touched, uint32_t now,
+                 cap1188_gesture_event_t *events, uint8_t maxEvents);
+  bool updateGroup(uint8_t group, bool touched, uint16_t position,
+                   uint32_t now, cap1188_gesture_event_t *event);
+
+private:
+  /*!  @brief Limits that tell gestures apart */
+  typedef struct {
+    uint16_t tapTime;       ///< Longest tap, in ms
+    uint16_t doubleTapGap;  ///< Longest gap within a double tap, in ms
+    uint16_t longPressTime; ///< Shortest long press, in ms
+    uint16_t swipeDistance; ///< Shortest swipe, in position units
+  } timing_t;
+
+  /*!  @brief State of one group */
+  typedef struct {
+    uint8_t mask;      ///< Inputs, or 0 for a position group
+    uint8_t state;     ///< Current state machine state
+    uint32_t since;    ///< Time the current state was entered
+    uint16_t start;    ///< Position at the first press
+    uint16_t position; ///< Latest position while pressed
+    timing_t timing;   ///< Limits of this group
+    bool queued;       ///< pending holds a gesture update() had no room for
+    cap1188_gesture_event_t pending; ///< Gesture to report first
+  } group_t;
+
+  bool step(uint8_t group, uint8_t input, uint16_t position, uint32_t now,
+            cap1188_gesture_event_t *event);
+
+  uint8_t _groups = 0;
+  group_t _group[CAP1188_GESTURE_GROUPS];
+  timing_t _defaults = {250, 300, 800, 512}; ///< Given to new groups
+};
+
+#endif
@@ -0,0 +1,118 @@
+/*!
+ *  @file Adafruit_CAP1188_Latency.cpp
+ *
+ *  Touch-to-event latency histogram for the CAP1188 8-Channel Capacitive
+ *  Sensor
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_CAP1188_Latency.h"
+
+/*!
+ *    @brief  Counts one latency. A bucket that is full halves every bucket,
+ *            which keeps the shape of the distribution and weighs recent
+ *            latencies more.
+ *    @param  us
+ *            latency in microseconds
+ */
+void Adafruit_CAP1188_Latency::add(uint32_t us) {
+  uint8_t i = bucketIndex(us);
+  if (_buckets[i] == 0xFFFF) {
+    _count = 0;
+    for (uint8_t j = 0; j < CAP1188_LATENCY_BUCKETS; j++) {
+      _buckets[j] /= 2;
+      _count += _buckets[j];
+    }
+  }
+  _buckets[i]++;
+  _count++;
+  if (us < _min) {
+    _min = us;
+  }
+  if (us > _max) {
+    _max = us;
+  }
+}
+
+/*!
+ *    @brief  Clears the histogram
+ */
+void Adafruit_CAP1188_Latency::reset() {
+  for (uint8_t i = 0; i < CAP1188_LATENCY_BUCKETS; i++) {
+    _buckets[i] = 0;
+  }
+  _count = 0;
+  _min = 0xFFFFFFFF;
+  _max = 0;
+}
+
+/*!
+ *    @brief  Gets a latency that the given share of latencies do not exceed
+ *    @param  percent
+ *            share from 0 to 100, e.g. 95 for the 95th percentile
+ *    @return Upper end of the bucket holding the percentile, at most the
+ *            longest latency, or 0 if none were added
+ */
+uint32_t Adafruit_CAP1188_Latency::percentile(uint8_t percent) const {
+  if (!_count) {
+    return 0;
+  }
+  if (percent == 0) {
+    return _min;
+  }
+  // Rank of the percentile, rounded up
+  uint32_t rank = _count / 100 * percent + (_count % 100 * percent + 99) / 100;
+  uint32_t seen = 0;
+  for (uint8_t i = 0; i < CAP1188_LATENCY_BUCKETS - 1; i++) {
+    seen += _buckets[i];
+    if (seen >= rank) {
+      uint32_t high = bucketLow(i + 1) - 1;
+      return high < _max ? high : _max;
+    }
+  }
+  return _max;
+}
+
+/*!
+ *    @brief  Gets the number of latencies in a bucket
+ *    @param  index
+ *            bucket, 0 to CAP1188_LATENCY_BUCKETS - 1
+ *    @return Latencies counted from bucketLow(index) up to
+ *            bucketLow(index + 1)
+ */
+uint16_t Adafruit_CAP1188_Latency::bucket(uint8_t index) const {
+  return index < CAP1188_LATENCY_BUCKETS ? _buckets[index] : 0;
+}
+
+/*!
+ *    @brief  Finds the bucket of a latency
+ *    @param  us
+ *            latency in microseconds
+ *    @return Bucket index
+ */
+uint8_t Adafruit_CAP1188_Latency::bucketIndex(uint32_t us) {
+  if (us < 4) {
+    return us;
+  }
+  // Power of two, then the next two bits
+  uint8_t msb = 2;
+  while (msb < 31 && (us >> (msb + 1))) {
+    msb++;
+  }
+  uint16_t i = (msb - 1) * 4 + ((us >> (msb - 2)) & 3);
+  return i < CAP1188_LATENCY_BUCKETS ? i : CAP1188_LATENCY_BUCKETS - 1;
+}
+
+/*!
+ *    @brief  Gets the shortest latency a bucket holds
+ *    @param  index
+ *            bucket index
+ *    @return Latency in microseconds
+ */
+uint32_t Adafruit_CAP1188_Latency::bucketLow(uint8_t index) {
+  if (index < 4) {
+    return index;
+  }
+  return (uint32_t)(4 + (index & 3)) << (index / 4 - 1);
+}
@@ -0,0 +1,45 @@
+/*!
+ *  @file Adafruit_CAP1188_Latency.h
+ *
+ *  Touch-to-event latency histogram for the CAP1188 8-Channel Capacitive
+ *  Sensor
+ *
+ *  Buckets are log-scale with four per power of two, so a percentile is
+ *  reported within 25% of the true value. Latencies from 0 to about 2 s
+ *  are resolved; longer ones count in the last bucket.
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef ADAFRUIT_CAP1188_LATENCY_H
+#define ADAFRUIT_CAP1188_LATENCY_H
+
+#include <stdint.h>
+
+#define CAP1188_LATENCY_BUCKETS 80 ///< Histogram buckets
+
+/*!
+ *    @brief  Fixed-size histogram of latencies in microseconds
+ */
+class Adafruit_CAP1188_Latency {
+public:
+  void add(uint32_t us);
+  void reset();
+
+  uint32_t count() const { return _count; } ///< Latencies added, see add()
+  uint32_t min() const { return _count ? _min : 0; } ///< Shortest latency
+  uint32_t max() const { return _max; }              ///< Longest latency
+  uint32_t percentile(uint8_t percent) const;
+  uint16_t bucket(uint8_t index) const;
+
+  static uint8_t bucketIndex(uint32_t us);
+  static uint32_t bucketLow(uint8_t index);
+
+private:
+  uint16_t _buckets[CAP1188_LATENCY_BUCKETS] = {0};
+  uint32_t _count = 0; ///< Sum of the buckets
+  uint32_t _min = 0xFFFFFFFF;
+  uint32_t _max = 0;
+};
+
+#endif
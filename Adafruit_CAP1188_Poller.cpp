@@ -0,0 +1,212 @@
+/*!
+ *  @file Adafruit_CAP1188_Poller.cpp
+ *
+ *  Phase-locked poller for the CAP1188 8-Channel Capacitive Sensor. The
+ *  sensor updates its status once per sensing cycle; a read that sees the
+ *  status change bounds that update to the time since the previous read.
+ *  Bounds from successive changes, carried forward by whole cycles, are
+ *  intersected until the update instant is known closely enough to read
+ *  just after it. The same intersections bound the actual cycle time, which
+ *  drifts from the computed one with the sensor's oscillator. Times are
+ *  micros() values and may wrap.
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_CAP1188_Poller.h"
+
+/*!
+ *    @brief  Instantiates a new poller
+ *    @param  guard
+ *            time in microseconds to read after the latest possible status
+ *            update, and the phase uncertainty accepted as locked
+ */
+Adafruit_CAP1188_Poller::Adafruit_CAP1188_Poller(uint16_t guard) {
+  _guard = guard ? guard : 1;
+}
+
+/*!
+ *    @brief  Forgets the learned phase, e.g. after the sensor was reset
+ */
+void Adafruit_CAP1188_Poller::reset() {
+  _known = false;
+  _started = false;
+}
+
+/*!
+ *    @brief  Sets the sensing cycle time. poll() takes it from the sensor.
+ *    @param  cycle
+ *            cycle time in microseconds, as from cycleTime()
+ */
+void Adafruit_CAP1188_Poller::setCycleTime(uint32_t cycle) {
+  if (cycle && cycle != _nominal) {
+    _nominal = cycle;
+    _known = false;
+    resetPeriod();
+  }
+}
+
+/*!
+ *    @brief  Checks whether the next read is due
+ *    @param  now
+ *            current time in microseconds
+ *    @return True if the status should be read now
+ */
+bool Adafruit_CAP1188_Poller::due(uint32_t now) const {
+  return !_started || (int32_t)(now - _next) >= 0;
+}
+
+/*!
+ *    @brief  Learns from a read and schedules the next one
+ *    @param  changed
+ *            true if the read saw a different status than the previous one
+ *    @param  now
+ *            time of the read in microseconds
+ */
+void Adafruit_CAP1188_Poller::update(bool changed, uint32_t now) {
+  if (changed && _started) {
+    // The update happened after the previous read, at most now
+    uint32_t lo = _last, hi = now;
+    if (_known) {
+      // Whole cycles between the known update and this one
+      uint32_t period = _pmin + (_pmax - _pmin) / 2;
+      uint32_t gap = (lo + (hi - lo) / 2) - (_lo + (_hi - _lo) / 2);
+      uint32_t n = (gap + period / 2) / period;
+      if (n == 0) {
+        n = 1;
+      }
+      uint32_t wlo = _lo + n * _pmin;
+      uint32_t whi = _hi + n * _pmax;
+      if (whi - wlo < period) {
+        // Where the known update, carried forward, can be now
+        if ((int32_t)(wlo - lo) > 0) {
+          lo = wlo;
+        }
+        if ((int32_t)(whi - hi) < 0) {
+          hi = whi;
+        }
+        // The cycle times that carry the known update there
+        uint32_t pmin = (int32_t)(hi - lo) >= 0 ? (lo - _hi) / n : 0;
+        uint32_t pmax = (hi - _lo) / n;
+        if (pmin < _pmin) {
+          pmin = _pmin;
+        }
+        if (pmax > _pmax) {
+          pmax = _pmax;
+        }
+        if ((int32_t)(hi - lo) >= 0 && pmin <= pmax) {
+          _pmin = pmin;
+          _pmax = pmax;
+        } else {
+          // Inconsistent with what was learned, start over from this change
+          lo = _last;
+          hi = now;
+          resetPeriod();
+        }
+      }
+    }
+    _lo = lo;
+    _hi = hi;
+    _known = true;
+  }
+  _last = now;
+  _started = true;
+  schedule(now);
+}
+
+/*!
+ *    @brief  Reads a snapshot if a read is due. Call
+ *            Adafruit_CAP1188::setInterruptPolicy() first, so that releases
+ *            show in the first snapshot after them rather than one read
+ *            later.
+ *    @param  cap
+ *            sensor to read
+ *    @param  now
+ *            current time in microseconds
+ *    @param  snapshot
+ *            filled with the captured status if a read was made
+ *    @return True if a snapshot was read
+ */
+bool Adafruit_CAP1188_Poller::poll(Adafruit_CAP1188 &cap, uint32_t now,
+                                   cap1188_snapshot_t *snapshot) {
+  if (!due(now)) {
+    return false;
+  }
+  setCycleTime(cap.cycleTime());
+  if (!cap.readSnapshot(snapshot)) {
+    schedule(now);
+    return false;
+  }
+  bool changed = snapshot->touched != _touched || snapshot->status != _status;
+  _touched = snapshot->touched;
+  _status = snapshot->status;
+  update(changed, now);
+  return true;
+}
+
+/*!
+ *    @brief  Checks whether reads are aligned to the status updates
+ *    @return True if the next update is known to within the guard time
+ */
+bool Adafruit_CAP1188_Poller::locked() const {
+  return _known && window() <= _guard;
+}
+
+/*!
+ *    @brief  Gets the uncertainty of the next update
+ *    @return Width of the window the next update lies in, in microseconds, or
+ *            the cycle time if it is not known
+ */
+uint32_t Adafruit_CAP1188_Poller::window() const {
+  if (!_known) {
+    return _nominal;
+  }
+  uint32_t k = cyclesAfter(_last);
+  return (_hi + k * _pmax) - (_lo + k * _pmin);
+}
+
+/*!
+ *    @brief  Counts the cycles from the known update to the first update
+ *            that can still come after a time
+ *    @param  time
+ *            time in microseconds
+ *    @return Cycles to carry the known update forward
+ */
+uint32_t Adafruit_CAP1188_Poller::cyclesAfter(uint32_t time) const {
+  int32_t d = (int32_t)(time - _hi);
+  return d < 0 ? 0 : (uint32_t)d / _pmax + 1;
+}
+
+/*!
+ *    @brief  Widens the learned cycle time back to the sensor's tolerance
+ */
+void Adafruit_CAP1188_Poller::resetPeriod() {
+  _pmin = _nominal - _nominal / CAP1188_POLLER_TOLERANCE;
+  _pmax = _nominal + _nominal / CAP1188_POLLER_TOLERANCE;
+}
+
+/*!
+ *    @brief  Picks the time of the next read
+ *    @param  now
+ *            time of the last read
+ */
+void Adafruit_CAP1188_Poller::schedule(uint32_t now) {
+  uint32_t k = _known ? cyclesAfter(now) : 0;
+  uint32_t lo = _lo + k * _pmin;
+  uint32_t hi = _hi + k * _pmax;
+  if (!_known || hi - lo >= _nominal) {
+    // Sample faster than the cycle until the update can be placed
+    _next = now + _nominal / CAP1188_POLLER_PROBES;
+    return;
+  }
+  if ((int32_t)(now - lo) > 0) {
+    lo = now;
+  }
+  uint32_t mid = lo + (hi - lo) / 2;
+  if (hi - lo > _guard && (int32_t)(mid - now) > 0) {
+    // Halve the window with a read in its middle
+    _next = mid;
+  } else {
+    _next = hi + _guard;
+  }
+}
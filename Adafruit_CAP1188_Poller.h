@@ -0,0 +1,58 @@
+/*!
+ *  @file Adafruit_CAP1188_Poller.h
+ *
+ *  Phase-locked poller for the CAP1188 8-Channel Capacitive Sensor
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef ADAFRUIT_CAP1188_POLLER_H
+#define ADAFRUIT_CAP1188_POLLER_H
+
+#include "Adafruit_CAP1188.h"
+
+#define CAP1188_POLLER_PROBES 4 ///< Reads per cycle while the phase is unknown
+#define CAP1188_POLLER_TOLERANCE                                               \
+  16 ///< The actual cycle time is assumed within 1/16 of the computed one
+
+/*!
+ *    @brief  Schedules status reads just after the sensor publishes a new
+ *            measurement. The instant within the sensing cycle at which the
+ *            status updates is learned from the reads that see it change,
+ *            and narrowed with an extra read per cycle until it is known to
+ *            within the guard time.
+ */
+class Adafruit_CAP1188_Poller {
+public:
+  Adafruit_CAP1188_Poller(uint16_t guard = 1000);
+
+  void reset();
+  void setCycleTime(uint32_t cycle);
+  bool due(uint32_t now) const;
+  void update(bool changed, uint32_t now);
+  bool poll(Adafruit_CAP1188 &cap, uint32_t now, cap1188_snapshot_t *snapshot);
+
+  bool locked() const;
+  uint32_t window() const;
+  uint32_t nextRead() const { return _next; } ///< micros() of the next read
+
+private:
+  uint32_t cyclesAfter(uint32_t time) const;
+  void resetPeriod();
+  void schedule(uint32_t now);
+
+  uint32_t _nominal = 70000; ///< Cycle time computed from the configuration
+  uint32_t _pmin = 65625;    ///< Shortest actual cycle time still possible
+  uint32_t _pmax = 74375;    ///< Longest actual cycle time still possible
+  uint32_t _lo = 0;   ///< Earliest time a known status update can have been
+  uint32_t _hi = 0;   ///< Latest time that status update can have been
+  uint32_t _last = 0; ///< Time of the previous read
+  uint32_t _next = 0; ///< Time of the next read
+  uint16_t _guard;    ///< Delay after the latest possible update
+  bool _known = false;   ///< _lo and _hi hold an update
+  bool _started = false; ///< A read has been made
+  uint8_t _touched = 0;  ///< Touch status seen by the previous read
+  uint8_t _status = 0;   ///< General Status seen by the previous read
+};
+
+#endif
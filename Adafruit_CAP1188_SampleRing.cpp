@@ -0,0 +1,132 @@
+/*!
+ *  @file Adafruit_CAP1188_SampleRing.cpp
+ *
+ *  Timestamped touch sample ring buffer for the CAP1188 8-Channel Capacitive
+ *  Sensor. The indices are single bytes so that they are read and written
+ *  atomically on every architecture, and run freely modulo 256.
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_CAP1188_SampleRing.h"
+
+/*!
+ *    @brief  Instantiates a ring over caller-provided storage
+ *    @param  samples
+ *            storage for the samples
+ *    @param  capacity
+ *            number of samples, a power of two up to 128
+ *    @param  deltas
+ *            optional storage for the delta counts of each sample
+ *    @param  overwrite
+ *            true to overwrite the oldest samples when full, false to drop
+ *            new samples
+ */
+Adafruit_CAP1188_SampleRing::Adafruit_CAP1188_SampleRing(
+    cap1188_sample_t *samples, uint8_t capacity, int8_t (*deltas)[8],
+    bool overwrite) {
+  // Round down to a power of two
+  uint8_t size = 1;
+  while (size <= 64 && (size << 1) <= capacity) {
+    size <<= 1;
+  }
+  _samples = samples;
+  _deltas = deltas;
+  _mask = size - 1;
+  _overwrite = overwrite;
+}
+
+/*!
+ *    @brief  Appends a sample. Producer side.
+ *    @param  status
+ *            General Status
+ *    @param  touched
+ *            Sensor Input Status
+ *    @param  deltas
+ *            delta counts of the eight inputs or NULL for zeros, ignored if
+ *            the ring does not store them
+ *    @param  now
+ *            current time in microseconds
+ *    @return True if the sample was stored
+ */
+bool Adafruit_CAP1188_SampleRing::push(uint8_t status, uint8_t touched,
+                                       const int8_t *deltas, uint32_t now) {
+  uint8_t head = _head;
+  if (!_overwrite && (uint8_t)(head - _tail) > _mask) {
+    if (_dropped != 0xFFFF)
+      _dropped++;
+    return false;
+  }
+  uint32_t dt = _started ? now - _lastTime : 0;
+  _started = true;
+  _lastTime = now;
+
+  cap1188_sample_t *s = &_samples[head & _mask];
+  s->dt = dt > 0xFFFF ? 0xFFFF : dt;
+  s->status = status;
+  s->touched = touched;
+  if (_deltas) {
+    if (deltas)
+      memcpy(_deltas[head & _mask], deltas, 8);
+    else
+      memset(_deltas[head & _mask], 0, 8);
+  }
+  // Publish the sample only once it is complete
+  CAP1188_RING_BARRIER();
+  _head = head + 1;
+  return true;
+}
+
+/*!
+ *    @brief  Gets the number of samples waiting. Consumer side. In overwrite
+ *            mode, samples overwritten by the producer are skipped.
+ *    @return Number of samples that can be consumed
+ */
+uint8_t Adafruit_CAP1188_SampleRing::available() {
+  uint8_t count = _head - _tail;
+  if (count > (uint8_t)(_mask + 1)) {
+    // Only happens in overwrite mode: the producer lapped us
+    uint8_t lost = count - (_mask + 1);
+    _overwritten =
+        (_overwritten > 0xFFFF - lost) ? 0xFFFF : _overwritten + lost;
+    _tail += lost;
+    count = _mask + 1;
+  }
+  return count;
+}
+
+/*!
+ *    @brief  Gets the oldest waiting samples in place, without copying.
+ *            Consumer side. Release them with consume().
+ *    @param  samples
+ *            set to the oldest waiting sample
+ *    @param  deltas
+ *            optional, set to the delta counts of that sample, or NULL if
+ *            the ring does not store them
+ *    @return Number of contiguous samples at samples, which may be fewer
+ *            than available() when the waiting samples wrap around
+ */
+uint8_t Adafruit_CAP1188_SampleRing::peek(const cap1188_sample_t **samples,
+                                          const int8_t (**deltas)[8]) {
+  uint8_t count = available();
+  CAP1188_RING_BARRIER();
+  uint8_t index = _tail & _mask;
+  uint8_t contiguous = _mask + 1 - index;
+  *samples = &_samples[index];
+  if (deltas) {
+    *deltas = _deltas ? &_deltas[index] : NULL;
+  }
+  return count < contiguous ? count : contiguous;
+}
+
+/*!
+ *    @brief  Releases samples returned by peek(). Consumer side.
+ *    @param  count
+ *            number of samples to release
+ */
+void Adafruit_CAP1188_SampleRing::consume(uint8_t count) {
+  uint8_t waiting = available();
+  // Finish reading the samples before handing their slots back
+  CAP1188_RING_BARRIER();
+  _tail += count < waiting ? count : waiting;
+}
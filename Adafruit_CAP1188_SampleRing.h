@@ -0,0 +1,99 @@
+/*!
+ *  @file Adafruit_CAP1188_SampleRing.h
+ *
+ *  Timestamped touch sample ring buffer for the CAP1188 8-Channel Capacitive
+ *  Sensor
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef ADAFRUIT_CAP1188_SAMPLERING_H
+#define ADAFRUIT_CAP1188_SAMPLERING_H
+
+#include "Arduino.h"
+
+#if defined(__AVR__)
+// Single core, only the compiler may reorder
+#define CAP1188_RING_BARRIER() __asm__ __volatile__("" ::: "memory")
+#else
+#define CAP1188_RING_BARRIER() __sync_synchronize()
+#endif
+
+/*!
+ *    @brief  One compact touch sample
+ */
+typedef struct {
+  uint16_t dt;     ///< Microseconds since the previous sample, saturating
+  uint8_t status;  ///< General Status, 0 if not read
+  uint8_t touched; ///< Sensor Input Status
+} cap1188_sample_t;
+
+/*!
+ *    @brief  Fixed-capacity ring of touch samples, with optional delta
+ *            counts, over caller-provided storage. One producer (polling
+ *            code or an ISR) and one consumer may use it concurrently
+ *            without locks. In overwrite mode the consumer must check in at
+ *            least once every 256 - capacity samples, and a sample being
+ *            read may be overwritten if the producer laps the consumer.
+ */
+class Adafruit_CAP1188_SampleRing {
+public:
+  Adafruit_CAP1188_SampleRing(cap1188_sample_t *samples, uint8_t capacity,
+                              int8_t (*deltas)[8] = NULL,
+                              bool overwrite = false);
+
+  // Producer
+  bool push(uint8_t status, uint8_t touched, const int8_t *deltas,
+            uint32_t now);
+  bool capturesDeltas() const { return _deltas != NULL; } ///< Has deltas
+  uint16_t dropped() const { return _dropped; } ///< Samples lost when full
+
+  // Consumer
+  uint8_t available();
+  uint8_t peek(const cap1188_sample_t **samples,
+               const int8_t (**deltas)[8] = NULL);
+  void consume(uint8_t count);
+  uint16_t overwritten() const { return _overwritten; } ///< Samples lost
+
+private:
+  cap1188_sample_t *_samples;
+  int8_t (*_deltas)[8];
+  uint8_t _mask;
+  bool _overwrite;
+  bool _started = false;
+  uint32_t _lastTime = 0;
+  volatile uint8_t _head = 0; ///< Free running, written by the producer
+  volatile uint8_t _tail = 0; ///< Free running, written by the consumer
+  uint16_t _dropped = 0;
+  uint16_t _overwritten = 0;
+};
+
+/*!
+ *    @brief  Adafruit_CAP1188_SampleRing with its own storage
+ *    @tparam N
+ *            capacity, a power of two up to 128
+ *    @tparam DELTAS
+ *            true to store the delta counts with each sample
+ */
+template <uint8_t N, bool DELTAS = false>
+class Adafruit_CAP1188_SampleBuffer : public Adafruit_CAP1188_SampleRing {
+  static_assert(N && N <= 128 && !(N & (N - 1)),
+                "capacity must be a power of two up to 128");
+
+public:
+  /*!
+   *    @brief  Instantiates an empty buffer
+   *    @param  overwrite
+   *            true to overwrite the oldest samples when full, false to drop
+   *            new samples
+   */
+  Adafruit_CAP1188_SampleBuffer(bool overwrite = false)
+      : Adafruit_CAP1188_SampleRing(_sampleStore, N,
+                                    DELTAS ? _deltaStore : NULL, overwrite) {}
+
+private:
+  cap1188_sample_t _sampleStore[N];
+  int8_t _deltaStore[DELTAS ? N : 1][8];
+};
+
+#endif
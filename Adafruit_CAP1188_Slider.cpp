@@ -0,0 +1,155 @@
+/*!
+ *  @file Adafruit_CAP1188_Slider.cpp
+ *
+ *  Slider and wheel position engine for the CAP1188 8-Channel Capacitive
+ *  Sensor. Positions are interpolated from the strongest input and its two
+ *  neighbours; nothing is allocated and no floating point is used.
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_CAP1188_Slider.h"
+
+/*!
+ *    @brief  Instantiates a new slider or wheel
+ *    @param  firstChannel
+ *            input of the first electrode, 0-7
+ *    @param  numChannels
+ *            number of adjacent electrodes, 2-8
+ *    @param  wheel
+ *            true if the last electrode is next to the first
+ */
+Adafruit_CAP1188_Slider::Adafruit_CAP1188_Slider(uint8_t firstChannel,
+                                                 uint8_t numChannels,
+                                                 bool wheel) {
+  _first = firstChannel & 7;
+  if (numChannels < 2)
+    numChannels = 2;
+  if (_first + numChannels > 8)
+    numChannels = 8 - _first;
+  _count = numChannels;
+  _wheel = wheel;
+}
+
+/*!
+ *    @brief  Sets the delta count the strongest electrode must reach for a
+ *            touch
+ *    @param  threshold
+ *            minimum delta count, 1-127
+ */
+void Adafruit_CAP1188_Slider::setThreshold(int8_t threshold) {
+  _threshold = threshold < 1 ? 1 : threshold;
+}
+
+/*!
+ *    @brief  Sets the position smoothing
+ *    @param  smoothing
+ *            weight of a new position is 1/2^smoothing, 0 disables smoothing
+ */
+void Adafruit_CAP1188_Slider::setSmoothing(uint8_t smoothing) {
+  _smoothing = smoothing > 8 ? 8 : smoothing;
+}
+
+/*!
+ *    @brief  Gets the number of distinct positions
+ *    @return Positions run from 0 to range() - 1
+ */
+uint16_t Adafruit_CAP1188_Slider::range() const {
+  // A slider ends on its last electrode, a wheel wraps back to the first
+  return (_wheel ? _count : _count - 1) * CAP1188_SLIDER_PITCH +
+         (_wheel ? 0 : 1);
+}
+
+/*!
+ *    @brief  Computes the position from a set of delta counts
+ *    @param  deltas
+ *            delta count of each input, as from readDeltas()
+ *    @param  now
+ *            current time in milliseconds, for the velocity
+ *    @return True if the slider is touched
+ */
+bool Adafruit_CAP1188_Slider::update(const int8_t deltas[8], uint32_t now) {
+  const int8_t *d = deltas + _first;
+  uint8_t peak = 0;
+  for (uint8_t i = 1; i < _count; i++) {
+    if (d[i] > d[peak])
+      peak = i;
+  }
+  if (d[peak] < _threshold) {
+    _touched = false;
+    _velocity = 0;
+    return false;
+  }
+
+  // Negative deltas carry no position information
+  int16_t prev = 0, next = 0;
+  if (peak > 0 || _wheel)
+    prev = d[peak > 0 ? peak - 1 : _count - 1];
+  if (peak < _count - 1 || _wheel)
+    next = d[peak < _count - 1 ? peak + 1 : 0];
+  if (prev < 0)
+    prev = 0;
+  if (next < 0)
+    next = 0;
+  int16_t sum = prev + d[peak] + next;
+  int32_t raw = (int32_t)peak * CAP1188_SLIDER_PITCH +
+                (int32_t)(next - prev) * CAP1188_SLIDER_PITCH / sum;
+
+  int32_t span = range();
+  if (_wheel) {
+    if (raw < 0)
+      raw += span;
+    else if (raw >= span)
+      raw -= span;
+  } else if (raw < 0) {
+    raw = 0;
+  } else if (raw >= span) {
+    raw = span - 1;
+  }
+
+  if (!_touched) {
+    _position = raw;
+    _velocity = 0;
+  } else {
+    int32_t step = raw - _position;
+    if (_wheel) {
+      // Take the short way around
+      if (step > span / 2)
+        step -= span;
+      else if (step < -span / 2)
+        step += span;
+    }
+    step >>= _smoothing;
+    int32_t pos = _position + step;
+    if (_wheel) {
+      if (pos < 0)
+        pos += span;
+      else if (pos >= span)
+        pos -= span;
+    }
+    uint32_t dt = now - _last;
+    if (dt) {
+      int32_t v = step * 1000 / (int32_t)dt;
+      _velocity = v > 32767 ? 32767 : (v < -32767 ? -32767 : v);
+    }
+    _position = pos;
+  }
+  _touched = true;
+  _last = now;
+  return true;
+}
+
+/*!
+ *    @brief  Reads the delta counts from the sensor in one burst and
+ *            computes the position
+ *    @param  cap
+ *            sensor the electrodes are connected to
+ *    @return True if the slider is touched
+ */
+bool Adafruit_CAP1188_Slider::update(Adafruit_CAP1188 &cap) {
+  int8_t deltas[8];
+  if (!cap.readDeltas(deltas)) {
+    return _touched;
+  }
+  return update(deltas, millis());
+}
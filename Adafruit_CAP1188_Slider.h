@@ -0,0 +1,50 @@
+/*!
+ *  @file Adafruit_CAP1188_Slider.h
+ *
+ *  Slider and wheel position engine for the CAP1188 8-Channel Capacitive
+ *  Sensor
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef ADAFRUIT_CAP1188_SLIDER_H
+#define ADAFRUIT_CAP1188_SLIDER_H
+
+#include "Adafruit_CAP1188.h"
+
+#define CAP1188_SLIDER_PITCH 256 ///< Position units between two electrodes
+
+/*!
+ *    @brief  Computes the finger position on a row (slider) or ring (wheel)
+ *            of adjacent inputs from their delta counts, using integer math
+ *            only
+ */
+class Adafruit_CAP1188_Slider {
+public:
+  Adafruit_CAP1188_Slider(uint8_t firstChannel, uint8_t numChannels,
+                          bool wheel = false);
+
+  void setThreshold(int8_t threshold);
+  void setSmoothing(uint8_t smoothing);
+
+  bool update(const int8_t deltas[8], uint32_t now);
+  bool update(Adafruit_CAP1188 &cap);
+
+  bool touched() const { return _touched; } ///< Finger on the slider
+  uint16_t position() const { return _position; } ///< Smoothed position
+  int16_t velocity() const { return _velocity; } ///< Units per second
+  uint16_t range() const;
+
+private:
+  uint8_t _first;
+  uint8_t _count;
+  bool _wheel;
+  int8_t _threshold = 16;
+  uint8_t _smoothing = 2;
+  bool _touched = false;
+  uint16_t _position = 0;
+  int16_t _velocity = 0;
+  uint32_t _last = 0; ///< Time of the previous touched update
+};
+
+#endif
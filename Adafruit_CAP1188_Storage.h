@@ -0,0 +1,45 @@
+/*!
+ *  @file Adafruit_CAP1188_Storage.h
+ *
+ *  Non-volatile storage interface for CAP1188 8-Channel Capacitive Sensor
+ *  configuration profiles
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef ADAFRUIT_CAP1188_STORAGE_H
+#define ADAFRUIT_CAP1188_STORAGE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*!
+ *    @brief  Somewhere to keep a configuration profile across power cycles,
+ *            see Adafruit_CAP1188::setStorage()
+ */
+class Adafruit_CAP1188_Storage {
+public:
+  virtual ~Adafruit_CAP1188_Storage() {}
+
+  /*!
+   *    @brief  Reads back a stored profile
+   *    @param  buffer
+   *            destination
+   *    @param  len
+   *            number of bytes to read
+   *    @return True if len bytes were read, false if nothing is stored
+   */
+  virtual bool read(uint8_t *buffer, size_t len) = 0;
+
+  /*!
+   *    @brief  Stores a profile, replacing the previous one
+   *    @param  buffer
+   *            bytes to store
+   *    @param  len
+   *            number of bytes
+   *    @return True if the bytes were stored
+   */
+  virtual bool write(const uint8_t *buffer, size_t len) = 0;
+};
+
+#endif
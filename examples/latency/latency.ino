@@ -0,0 +1,75 @@
+/***************************************************
+  This is a library for the CAP1188 I2C/SPI 8-chan Capacitive Sensor
+
+  Measures how long a touch takes from the sensor's ALERT edge to
+  touched() returning it, and prints percentiles every 10 seconds.
+
+  Designed specifically to work with the CAP1188 sensor from Adafruit
+  ----> https://www.adafruit.com/products/1602
+
+  BSD license, all text above must be included in any redistribution
+ ****************************************************/
+
+#include <Wire.h>
+#include <SPI.h>
+#include <Adafruit_CAP1188.h>
+#include <Adafruit_CAP1188_Latency.h>
+
+// ALERT connected to an interrupt capable pin
+#define CAP1188_ALERT 2
+
+// Use I2C, no reset pin!
+Adafruit_CAP1188 cap = Adafruit_CAP1188();
+
+// Touch-to-event latencies
+Adafruit_CAP1188_Latency latency;
+
+// ESP cores need interrupt handlers in IRAM, other cores lack the attribute
+#ifndef IRAM_ATTR
+#define IRAM_ATTR
+#endif
+
+#if CAP1188_LATENCY
+void IRAM_ATTR onAlert() { cap.alertEdge(); }
+#endif
+
+uint32_t lastReport = 0;
+
+void setup() {
+  Serial.begin(9600);
+  Serial.println("CAP1188 touch latency");
+
+#if !CAP1188_LATENCY
+  Serial.println("Set CAP1188_LATENCY to 1 in Adafruit_CAP1188_Config.h");
+  while (1);
+#else
+  if (!cap.begin()) {
+    Serial.println("CAP1188 not found");
+    while (1);
+  }
+  cap.setInterruptPolicy(CAP1188_INT_PRESS_RELEASE);
+  cap.setAlertPin(CAP1188_ALERT);
+  cap.setLatencyHistogram(&latency);
+  attachInterrupt(digitalPinToInterrupt(CAP1188_ALERT), onAlert, FALLING);
+#endif
+}
+
+void loop() {
+  cap.touched();
+
+  if (millis() - lastReport >= 10000) {
+    lastReport = millis();
+    Serial.print("n=");
+    Serial.print(latency.count());
+    Serial.print(" p50=");
+    Serial.print(latency.percentile(50));
+    Serial.print("us p95=");
+    Serial.print(latency.percentile(95));
+    Serial.print("us p99=");
+    Serial.print(latency.percentile(99));
+    Serial.print("us max=");
+    Serial.print(latency.max());
+    Serial.println("us");
+    latency.reset();
+  }
+}
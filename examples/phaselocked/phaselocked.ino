@@ -0,0 +1,63 @@
+/***************************************************
+  This is a library for the CAP1188 I2C/SPI 8-chan Capacitive Sensor
+
+  Reads the status just after the sensor publishes each measurement,
+  instead of at a fixed interval unrelated to its sensing cycle. Prints
+  when the poller has locked onto the cycle.
+
+  Designed specifically to work with the CAP1188 sensor from Adafruit
+  ----> https://www.adafruit.com/products/1602
+
+  BSD license, all text above must be included in any redistribution
+ ****************************************************/
+
+#include <Wire.h>
+#include <SPI.h>
+#include <Adafruit_CAP1188.h>
+#include <Adafruit_CAP1188_Poller.h>
+
+// Use I2C, no reset pin!
+Adafruit_CAP1188 cap = Adafruit_CAP1188();
+
+// Read 1 ms after the latest possible update
+Adafruit_CAP1188_Poller poller(1000);
+
+bool wasLocked = false;
+uint8_t lastTouched = 0;
+
+void setup() {
+  Serial.begin(9600);
+  Serial.println("CAP1188 phase-locked polling");
+
+  if (!cap.begin()) {
+    Serial.println("CAP1188 not found");
+    while (1);
+  }
+  // Read the touch status again after clearing a release interrupt, so
+  // that a release shows in the first read after it
+  cap.setInterruptPolicy(CAP1188_INT_PRESS_RELEASE);
+}
+
+void loop() {
+  cap1188_snapshot_t snapshot;
+  if (!poller.poll(cap, micros(), &snapshot)) {
+    return;
+  }
+
+  if (poller.locked() != wasLocked) {
+    wasLocked = poller.locked();
+    Serial.println(wasLocked ? "Locked to the sensing cycle" : "Lock lost");
+  }
+
+  if (snapshot.touched != lastTouched) {
+    lastTouched = snapshot.touched;
+    for (uint8_t i = 0; i < 8; i++) {
+      if (lastTouched & (1 << i)) {
+        Serial.print("C");
+        Serial.print(i + 1);
+        Serial.print("\t");
+      }
+    }
+    Serial.println();
+  }
+}
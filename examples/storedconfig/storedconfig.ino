@@ -0,0 +1,74 @@
+/***************************************************
+  This is a library for the CAP1188 I2C/SPI 8-chan Capacitive Sensor
+
+  Tunes the sensor on the first boot and keeps the result in EEPROM, so
+  that later boots apply the tuned configuration in a few block writes
+  instead of tuning again.
+
+  Designed specifically to work with the CAP1188 sensor from Adafruit
+  ----> https://www.adafruit.com/products/1602
+
+  BSD license, all text above must be included in any redistribution
+ ****************************************************/
+
+#include <Wire.h>
+#include <SPI.h>
+#include <Adafruit_CAP1188.h>
+#include <Adafruit_CAP1188_EEPROMStorage.h>
+
+// Use I2C, no reset pin!
+Adafruit_CAP1188 cap = Adafruit_CAP1188();
+
+// Profile kept at the start of the EEPROM
+Adafruit_CAP1188_EEPROMStorage storage(0);
+
+void tune() {
+  // Stand-in for a real end-of-line tuning routine
+  uint8_t thresholds[8] = {0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30};
+  cap.setSensitivity(CAP1188_SENSITIVITY_64X);
+  cap.setThresholds(thresholds);
+}
+
+void setup() {
+  Serial.begin(9600);
+  Serial.println("CAP1188 stored configuration");
+
+#if !CAP1188_STORED_CONFIG
+  Serial.println("Set CAP1188_STORED_CONFIG to 1 in Adafruit_CAP1188_Config.h");
+  while (1);
+#else
+#if defined(ESP8266) || defined(ESP32) || defined(ARDUINO_ARCH_RP2040)
+  EEPROM.begin(CAP1188_PROFILE_SIZE);
+#endif
+  cap.setStorage(&storage);
+  if (!cap.begin()) {
+    Serial.println("CAP1188 not found");
+    while (1);
+  }
+
+  if (cap.storedConfig()) {
+    Serial.println("Applied the stored profile");
+  } else {
+    Serial.println("No stored profile, tuning");
+    tune();
+    if (!cap.saveConfig()) {
+      Serial.println("Could not store the profile");
+    }
+  }
+#endif
+}
+
+void loop() {
+  uint8_t touched = cap.touched();
+  for (uint8_t i = 0; i < 8; i++) {
+    if (touched & (1 << i)) {
+      Serial.print("C");
+      Serial.print(i + 1);
+      Serial.print("\t");
+    }
+  }
+  if (touched) {
+    Serial.println();
+  }
+  delay(50);
+}
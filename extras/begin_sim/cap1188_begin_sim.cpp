@@ -0,0 +1,125 @@
+/*!
+ *  @file cap1188_begin_sim.cpp
+ *
+ *  Host simulation of the CAP1188 driver's begin() against the simulated
+ *  sensor, over I2C and over SPI. A warm start must keep a sensor that is
+ *  still configured without resetting or writing it, while a cold begin(),
+ *  or a warm start on a sensor fresh from power-on, must configure it. A
+ *  sensor that is still held in reset when begin() starts must be found once
+ *  the reset pulse has released it, and a missing sensor without a reset pin
+ *  must be given up on without the reset delays.
+ *
+ *  Build and run from extras/ with:
+ *    make check
+ *
+ *  Exits with 1 if begin() gets any of the cases wrong.
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_CAP1188.h"
+#include "cap1188_sim.h"
+
+#include <stdio.h>
+
+#define RESET_PIN 5
+
+static bool fail(const char *what, bool spi) {
+  printf("FAIL: %s over %s\n", what, spi ? "SPI" : "I2C");
+  return false;
+}
+
+// Runs begin() on a fresh driver, returns its result and whether it kept
+// the sensor's configuration
+static bool begin(bool spi, int8_t resetPin, bool warmStart = false,
+                  bool *warmStarted = NULL) {
+  Adafruit_CAP1188 i2cCap(resetPin);
+  Adafruit_CAP1188 spiCap(10, resetPin);
+  Adafruit_CAP1188 *cap = spi ? &spiCap : &i2cCap;
+  cap->setWarmStart(warmStart);
+  bool ok = cap->begin();
+  if (warmStarted)
+    *warmStarted = cap->warmStarted();
+  return ok;
+}
+
+// Checks that begin() wrote its settings, as after a reset
+static bool configured() {
+  return cap1188Sim.regs[CAP1188_MTBLK] == 0 &&
+         cap1188Sim.regs[CAP1188_LEDLINK] == 0xFF &&
+         cap1188Sim.regs[CAP1188_STANDBYCFG] == 0x30;
+}
+
+static bool warmAndCold(bool spi, int8_t resetPin) {
+  bool warm;
+  cap1188Sim.present = true;
+  cap1188Sim.resetPin = resetPin;
+  cap1188Sim.held = false;
+  cap1188Sim.powerOn();
+  if (!begin(spi, resetPin, true, &warm) || warm || !configured())
+    return fail("warm start did not configure a sensor fresh from power-on",
+                spi);
+
+  // As if the sketch had then set it up, and the microcontroller rebooted
+  cap1188Sim.regs[CAP1188_LEDLINK] = 0x0F;
+  cap1188Sim.touch(0x01);
+  uint32_t start = cap1188Sim.time;
+  cap1188Sim.resetTraffic();
+  if (!begin(spi, resetPin, true, &warm) || !warm)
+    return fail("warm start did not keep a configured sensor", spi);
+  if (cap1188Sim.regs[CAP1188_LEDLINK] != 0x0F ||
+      !(cap1188Sim.regs[CAP1188_SENINPUTSTATUS] & 0x01))
+    return fail("warm start reset or rewrote the sensor", spi);
+  if (cap1188Sim.time != start)
+    return fail("warm start waited for the reset delays", spi);
+  printf("warm begin() over %s, reset pin %s: %u transactions, %u bytes\n",
+         spi ? "SPI" : "I2C", resetPin < 0 ? "no " : "yes",
+         (unsigned)cap1188Sim.transactions, (unsigned)cap1188Sim.bytes);
+
+  cap1188Sim.touch(0);
+  if (!begin(spi, resetPin, false, &warm) || warm || !configured())
+    return fail("cold begin() did not configure the sensor", spi);
+  return true;
+}
+
+// The sensor comes out of a previous run held in reset
+static bool heldInReset(bool spi) {
+  cap1188Sim.present = true;
+  cap1188Sim.resetPin = RESET_PIN;
+  cap1188Sim.powerOn();
+  cap1188Sim.held = true;
+  if (!begin(spi, RESET_PIN))
+    return fail("sensor held in reset not found", spi);
+  if (cap1188Sim.held)
+    return fail("sensor left in reset", spi);
+  if (cap1188Sim.regs[CAP1188_STANDBYCFG] == CAP1188_STANDBYCFG_DEFAULT)
+    return fail("sensor released from reset not configured", spi);
+  return true;
+}
+
+static bool missing(bool spi) {
+  cap1188Sim.present = false;
+  cap1188Sim.resetPin = -1;
+  cap1188Sim.held = false;
+  uint32_t start = cap1188Sim.time;
+  bool found = begin(spi, -1);
+  uint32_t took = cap1188Sim.time - start;
+  cap1188Sim.present = true;
+  if (found)
+    return fail("missing sensor found", spi);
+  if (took)
+    return fail("missing sensor waited for the reset delays", spi);
+  return true;
+}
+
+int main() {
+  bool ok = true;
+  for (int spi = 0; spi < 2; spi++) {
+    ok = warmAndCold(spi, -1) && ok;
+    ok = warmAndCold(spi, RESET_PIN) && ok;
+    ok = heldInReset(spi) && ok;
+    ok = missing(spi) && ok;
+  }
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
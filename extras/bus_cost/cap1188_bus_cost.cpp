@@ -0,0 +1,182 @@
+/*!
+ *  @file cap1188_bus_cost.cpp
+ *
+ *  Host benchmark of the bus cost of each public operation of the CAP1188
+ *  driver, run against the simulated sensor over I2C and over SPI. Prints
+ *  the transactions, bytes and wire time of every operation, and fails when
+ *  one costs more than the committed baseline below, or when the driver's
+ *  accounting from getBusStats() disagrees with the traffic the simulated
+ *  sensor saw. I2C runs with the 32 byte BusIO buffer of AVR boards, the
+ *  smallest in common use, so block reads are split as on an Uno.
+ *
+ *  Build and run from extras/ with:
+ *    make bus_cost/cap1188_bus_cost && ./bus_cost/cap1188_bus_cost
+ *
+ *  Exits with 1 on a regression, so that `make check` fails.
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_CAP1188.h"
+#include "cap1188_sim.h"
+
+#include <stdio.h>
+
+typedef struct {
+  const char *name;
+  void (*run)();
+  uint16_t i2cTransactions; // Baseline over I2C
+  uint16_t i2cBytes;
+  uint16_t spiTransactions; // Baseline over SPI
+  uint16_t spiBytes;
+} operation_t;
+
+static Adafruit_CAP1188 *cap;
+static uint8_t thresholds[8] = {0x40, 0x40, 0x40, 0x40,
+                                0x40, 0x40, 0x40, 0x40};
+static int8_t deltas[8];
+static uint8_t counts[8];
+static cap1188_snapshot_t snapshot;
+static uint8_t dump[CAP1188_DUMP_SIZE];
+static cap1188_led_config_t ledConfig = {
+    {4, 1, 15, 0}, {4, 1, 15, 0}, {16, 1, 15, 0}, 15, 0, 0, 0, 0, 0, false};
+
+static void opBegin() { cap->begin(); }
+static void opWarmBegin() {
+  cap->setWarmStart(true);
+  cap->begin();
+  cap->setWarmStart(false);
+}
+static void opTouched() { cap->touched(); }
+static void opSnapshot() { cap->readSnapshot(&snapshot); }
+static void opLEDpolarity() { cap->LEDpolarity(0); }
+static void opSetThresholds() { cap->setThresholds(thresholds); }
+static void opGetThresholds() { cap->getThresholds(thresholds); }
+static void opReadDeltas() { cap->readDeltas(deltas); }
+static void opReadBaseCounts() { cap->readBaseCounts(counts); }
+static void opUpdateLEDs() {
+  cap->setLED(0, true);
+  cap->setLED(1, true);
+  cap->updateLEDs();
+  cap->setLEDs(0);
+  cap->updateLEDs();
+}
+static void opLEDConfig() { cap->setLEDConfig(&ledConfig); }
+static void opCheckHealth() { cap->checkHealth(); }
+static void opRestoreConfig() { cap->restoreConfig(); }
+static void opDumpRegisters() { cap->dumpRegisters(dump); }
+static void opRestoreRegisters() { cap->restoreRegisters(dump); }
+static void opFrameCache() {
+  cap->setFrameCache(true);
+  for (uint8_t i = 0; i < 4; i++) {
+    cap->touched();
+  }
+  cap->setFrameCache(false);
+}
+static void opInterruptPolicy() {
+  cap->setInterruptPolicy(CAP1188_INT_PRESS_RELEASE);
+}
+
+// Baseline transactions and bytes per call with the sensor untouched
+static const operation_t operations[] = {
+    {"begin()", opBegin, 7, 99, 6, 99},
+    {"begin() warm start", opWarmBegin, 4, 90, 3, 87},
+    {"touched()", opTouched, 1, 4, 1, 4},
+    {"touched() again", opTouched, 1, 2, 1, 4},
+    {"readSnapshot()", opSnapshot, 1, 14, 1, 14},
+    {"LEDpolarity()", opLEDpolarity, 1, 3, 1, 4},
+    {"setThresholds()", opSetThresholds, 1, 10, 1, 18},
+    {"getThresholds()", opGetThresholds, 1, 11, 1, 11},
+    {"readDeltas()", opReadDeltas, 1, 11, 1, 11},
+    {"readBaseCounts()", opReadBaseCounts, 1, 11, 1, 11},
+    {"setLED() x2, updateLEDs() x2", opUpdateLEDs, 2, 6, 2, 8},
+    {"setLEDConfig()", opLEDConfig, 3, 16, 3, 26},
+    {"checkHealth()", opCheckHealth, 1, 4, 1, 4},
+    {"restoreConfig()", opRestoreConfig, 13, 70, 13, 114},
+    {"dumpRegisters()", opDumpRegisters, 5, 129, 5, 127},
+    {"restoreRegisters()", opRestoreRegisters, 14, 73, 14, 118},
+    {"touched() x4 frame cached", opFrameCache, 1, 4, 1, 4},
+    // Switches touched() to interrupt-driven reads, keep these last
+    {"setInterruptPolicy()", opInterruptPolicy, 3, 10, 3, 12},
+    {"touched() interrupt-driven", opTouched, 1, 4, 1, 4},
+    {"touched() interrupt-driven again", opTouched, 1, 2, 1, 4},
+};
+
+#define OPERATIONS (sizeof(operations) / sizeof(operations[0]))
+
+static cap1188_bus_stats_t costs[2][OPERATIONS];
+
+// Runs every operation on one bus, returns false if the driver's accounting
+// and the simulated sensor disagree
+static bool measure(bool spi) {
+  Adafruit_CAP1188 i2cCap;
+  Adafruit_CAP1188 spiCap(10, -1);
+  cap = spi ? &spiCap : &i2cCap;
+  cap1188Sim.powerOn();
+  if (!cap->begin()) {
+    fprintf(stderr, "begin() failed over %s\n", spi ? "SPI" : "I2C");
+    return false;
+  }
+
+  bool agree = true;
+  for (size_t i = 0; i < OPERATIONS; i++) {
+    cap1188_bus_stats_t *stats = &costs[spi][i];
+    cap->resetBusStats();
+    cap1188Sim.resetTraffic();
+    operations[i].run();
+    cap->getBusStats(stats);
+
+    uint32_t bits = cap1188Sim.bytes * (spi ? 8 : 9) + cap1188Sim.conditions;
+    if (stats->transactions != cap1188Sim.transactions ||
+        stats->bytes != cap1188Sim.bytes || stats->bits != bits) {
+      printf("%s over %s: driver counted %u/%u/%u, the bus carried "
+             "%u/%u/%u transactions/bytes/bits\n",
+             operations[i].name, spi ? "SPI" : "I2C", stats->transactions,
+             stats->bytes, stats->bits, cap1188Sim.transactions,
+             cap1188Sim.bytes, bits);
+      agree = false;
+    }
+  }
+  return agree;
+}
+
+int main() {
+  bool ok = measure(false);
+  ok = measure(true) && ok;
+
+  printf("%-34s %26s %17s\n", "", "I2C", "SPI");
+  printf("%-34s %4s %5s %7s %7s %4s %5s %6s\n", "operation", "tx", "bytes",
+         "100kHz", "400kHz", "tx", "bytes", "2MHz");
+  for (size_t i = 0; i < OPERATIONS; i++) {
+    const operation_t *op = &operations[i];
+    const cap1188_bus_stats_t *i2c = &costs[0][i];
+    const cap1188_bus_stats_t *spi = &costs[1][i];
+    printf("%-34s %4u %5u %5uus %5uus %4u %5u %4uus\n", op->name,
+           i2c->transactions, i2c->bytes,
+           Adafruit_CAP1188::wireTime(i2c, 100000),
+           Adafruit_CAP1188::wireTime(i2c, 400000), spi->transactions,
+           spi->bytes, Adafruit_CAP1188::wireTime(spi, 2000000));
+  }
+
+  for (size_t i = 0; i < OPERATIONS; i++) {
+    const operation_t *op = &operations[i];
+    const cap1188_bus_stats_t *i2c = &costs[0][i];
+    const cap1188_bus_stats_t *spi = &costs[1][i];
+    bool fits = i2c->transactions <= op->i2cTransactions &&
+                i2c->bytes <= op->i2cBytes &&
+                spi->transactions <= op->spiTransactions &&
+                spi->bytes <= op->spiBytes;
+    // Also flag a cost below the baseline, so that gains get committed
+    if (!fits || i2c->transactions < op->i2cTransactions ||
+        i2c->bytes < op->i2cBytes || spi->transactions < op->spiTransactions ||
+        spi->bytes < op->spiBytes) {
+      printf("%s: I2C %u/%u SPI %u/%u, baseline I2C %u/%u SPI %u/%u%s\n",
+             op->name, i2c->transactions, i2c->bytes, spi->transactions,
+             spi->bytes, op->i2cTransactions, op->i2cBytes, op->spiTransactions,
+             op->spiBytes, fits ? ", update the baseline" : " REGRESSION");
+    }
+    ok = ok && fits;
+  }
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,130 @@
+/*!
+ *  @file cap1188_capture_decode.cpp
+ *
+ *  Linux host tool that decodes CAP1188 capture files written with
+ *  Adafruit_CAP1188_CaptureEncoder to CSV. The capture is memory-mapped and
+ *  the CSV is formatted into a large output buffer, so decoding runs at
+ *  memory speed rather than stdio speed.
+ *
+ *  Build from this directory with:
+ *    c++ -O2 -I../.. -o cap1188_capture_decode cap1188_capture_decode.cpp \
+ *        ../../Adafruit_CAP1188_Capture.cpp
+ *
+ *  Usage: cap1188_capture_decode capture.bin > capture.csv
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_CAP1188_Capture.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static char out[1 << 16];
+static size_t outLen;
+
+static void flush() {
+  size_t done = 0;
+  while (done < outLen) {
+    ssize_t n = write(STDOUT_FILENO, out + done, outLen - done);
+    if (n <= 0) {
+      perror("write");
+      _exit(1);
+    }
+    done += n;
+  }
+  outLen = 0;
+}
+
+static void putText(const char *s) {
+  while (*s)
+    out[outLen++] = *s++;
+}
+
+static void putUnsigned(uint32_t v) {
+  char digits[10];
+  uint8_t n = 0;
+  do {
+    digits[n++] = '0' + v % 10;
+    v /= 10;
+  } while (v);
+  while (n)
+    out[outLen++] = digits[--n];
+}
+
+static void putSigned(int v) {
+  if (v < 0) {
+    out[outLen++] = '-';
+    v = -v;
+  }
+  putUnsigned(v);
+}
+
+int main(int argc, char **argv) {
+  if (argc != 2) {
+    fprintf(stderr, "usage: %s capture.bin\n", argv[0]);
+    return 2;
+  }
+  int fd = open(argv[1], O_RDONLY);
+  struct stat st;
+  if (fd < 0 || fstat(fd, &st) < 0) {
+    perror(argv[1]);
+    return 1;
+  }
+  size_t len = st.st_size;
+  const uint8_t *data = (const uint8_t *)"";
+  if (len) {
+    data = (const uint8_t *)mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      perror("mmap");
+      return 1;
+    }
+    madvise((void *)data, len, MADV_SEQUENTIAL);
+  }
+
+  Adafruit_CAP1188_CaptureDecoder decoder;
+  size_t pos = decoder.header(data, len);
+  if (!pos) {
+    fprintf(stderr, "%s: not a CAP1188 capture\n", argv[1]);
+    return 1;
+  }
+
+  putText("time_us,status,noise,touched,d1,d2,d3,d4,d5,d6,d7,d8\n");
+  unsigned long frames = 0;
+  while (pos < len) {
+    cap1188_frame_t f;
+    size_t used = decoder.decode(data + pos, len - pos, &f);
+    if (!used) {
+      fprintf(stderr, "%s: truncated or corrupt frame at offset %zu\n",
+              argv[1], pos);
+      flush();
+      return 1;
+    }
+    pos += used;
+    if (!decoder.synced())
+      continue;
+    // One line is at most about 80 characters
+    if (outLen > sizeof(out) - 128)
+      flush();
+    putUnsigned(f.time);
+    out[outLen++] = ',';
+    putUnsigned(f.status);
+    out[outLen++] = ',';
+    putUnsigned(f.noise);
+    out[outLen++] = ',';
+    putUnsigned(f.touched);
+    for (uint8_t i = 0; i < 8; i++) {
+      out[outLen++] = ',';
+      putSigned(f.deltas[i]);
+    }
+    out[outLen++] = '\n';
+    frames++;
+  }
+  flush();
+  fprintf(stderr, "%lu frames\n", frames);
+  return 0;
+}
@@ -0,0 +1,185 @@
+/*!
+ *  @file cap1188_capture_test.cpp
+ *
+ *  Host round-trip test of the CAP1188 capture format. Encodes random
+ *  frames, with ±255 delta jumps, timestamp wraps and key frames, and checks
+ *  that they decode field by field to the same frames, that decoding from
+ *  the middle of a capture resyncs on the next key frame, and that
+ *  truncated frames are rejected without disturbing the decoder.
+ *
+ *  Build and run from extras/ with:
+ *    make check
+ *
+ *  Exits with 1 on the first mismatch.
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_CAP1188_Capture.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define FRAMES 20000
+#define KEY_INTERVAL 16
+
+static cap1188_frame_t frames[FRAMES];
+static size_t offsets[FRAMES + 1]; // Start of each frame in capture
+static uint8_t capture[CAP1188_CAPTURE_HEADER_SIZE +
+                       FRAMES * CAP1188_CAPTURE_MAX_FRAME];
+static uint32_t seed = 1;
+
+// Small deterministic generator, so that failures reproduce everywhere
+static uint32_t random32() {
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return seed;
+}
+
+static bool chance(uint8_t percent) { return random32() % 100 < percent; }
+
+static void generate() {
+  cap1188_frame_t f;
+  memset(&f, 0, sizeof(f));
+  f.time = 0xFFF00000; // Wraps around early on
+  for (size_t n = 0; n < FRAMES; n++) {
+    uint32_t r = random32();
+    // Mostly the 35 ms cycle, sometimes long gaps
+    f.time += chance(5) ? r : 30000 + r % 10000;
+    if (chance(10))
+      f.status = random32();
+    if (chance(10))
+      f.noise = random32();
+    if (chance(20))
+      f.touched = random32();
+    for (uint8_t i = 0; i < 8; i++) {
+      if (chance(5)) {
+        // Largest jump in either direction
+        f.deltas[i] = f.deltas[i] < 0 ? 127 : -128;
+      } else if (chance(40)) {
+        f.deltas[i] = random32();
+      }
+    }
+    frames[n] = f;
+  }
+}
+
+static bool same(const cap1188_frame_t *a, const cap1188_frame_t *b) {
+  if (a->time != b->time || a->status != b->status || a->noise != b->noise ||
+      a->touched != b->touched) {
+    return false;
+  }
+  for (uint8_t i = 0; i < 8; i++) {
+    if (a->deltas[i] != b->deltas[i])
+      return false;
+  }
+  return true;
+}
+
+static bool fail(const char *what, size_t n) {
+  printf("FAIL: %s at frame %zu\n", what, n);
+  return false;
+}
+
+static bool encode(size_t *len) {
+  Adafruit_CAP1188_CaptureEncoder encoder(KEY_INTERVAL);
+  size_t pos = encoder.header(capture, sizeof(capture));
+  if (pos != CAP1188_CAPTURE_HEADER_SIZE)
+    return fail("header not written", 0);
+  for (size_t n = 0; n < FRAMES; n++) {
+    // A frame that does not fit must leave the encoder untouched
+    uint8_t small[2];
+    if (n % 97 == 0 && encoder.encode(&frames[n], small, sizeof(small)))
+      return fail("encoded into a too small buffer", n);
+    offsets[n] = pos;
+    size_t used = encoder.encode(&frames[n], capture + pos,
+                                 sizeof(capture) - pos);
+    if (!used || used > CAP1188_CAPTURE_MAX_FRAME)
+      return fail("bad encoded size", n);
+    pos += used;
+  }
+  offsets[FRAMES] = pos;
+  *len = pos;
+  return true;
+}
+
+static bool roundTrip(size_t len) {
+  Adafruit_CAP1188_CaptureDecoder decoder;
+  size_t pos = decoder.header(capture, len);
+  if (pos != CAP1188_CAPTURE_HEADER_SIZE)
+    return fail("header rejected", 0);
+  for (size_t n = 0; n < FRAMES; n++) {
+    cap1188_frame_t f;
+    size_t frameLen = offsets[n + 1] - offsets[n];
+    // Every proper prefix is truncated, and must not disturb the decoder
+    for (size_t cut = 0; cut < frameLen; cut++) {
+      if (decoder.decode(capture + pos, cut, &f))
+        return fail("truncated frame decoded", n);
+    }
+    if (decoder.decode(capture + pos, len - pos, &f) != frameLen)
+      return fail("wrong frame length", n);
+    if (!decoder.synced() || !same(&f, &frames[n]))
+      return fail("frame differs", n);
+    pos += frameLen;
+  }
+  return pos == len || fail("trailing bytes", FRAMES);
+}
+
+// Starts decoding at every frame in turn, as after a lost capture start
+static bool resync(size_t len) {
+  for (size_t start = 1; start < 4 * KEY_INTERVAL; start++) {
+    Adafruit_CAP1188_CaptureDecoder decoder;
+    size_t pos = offsets[start];
+    for (size_t n = start; n < start + 2 * KEY_INTERVAL; n++) {
+      cap1188_frame_t f;
+      memset(&f, 0xA5, sizeof(f));
+      size_t used = decoder.decode(capture + pos, len - pos, &f);
+      if (used != offsets[n + 1] - offsets[n])
+        return fail("wrong frame length before sync", n);
+      pos += used;
+      if (!decoder.synced()) {
+        if (n % KEY_INTERVAL == 0)
+          return fail("key frame did not sync", n);
+        if (f.time != 0xA5A5A5A5)
+          return fail("frame filled before sync", n);
+      } else if (!same(&f, &frames[n])) {
+        return fail("frame differs after sync", n);
+      }
+    }
+    if (!decoder.synced())
+      return fail("never synced", start);
+  }
+  return true;
+}
+
+static bool headers() {
+  uint8_t header[CAP1188_CAPTURE_HEADER_SIZE];
+  Adafruit_CAP1188_CaptureEncoder encoder;
+  Adafruit_CAP1188_CaptureDecoder decoder;
+  if (encoder.header(header, sizeof(header) - 1))
+    return fail("header written into a too small buffer", 0);
+  encoder.header(header, sizeof(header));
+  if (decoder.header(header, sizeof(header) - 1))
+    return fail("truncated header accepted", 0);
+  header[5]++;
+  if (decoder.header(header, sizeof(header)))
+    return fail("other version accepted", 0);
+  header[5]--;
+  header[0] ^= 1;
+  if (decoder.header(header, sizeof(header)))
+    return fail("bad magic accepted", 0);
+  return true;
+}
+
+int main() {
+  generate();
+  size_t len;
+  bool ok = headers() && encode(&len) && roundTrip(len) && resync(len);
+  if (ok) {
+    printf("%u frames in %zu bytes, %.2f bytes per frame\n", FRAMES, len,
+           (double)(len - CAP1188_CAPTURE_HEADER_SIZE) / FRAMES);
+  }
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,311 @@
+/*!
+ *  @file cap1188_gesture_replay.cpp
+ *
+ *  Host harness that replays touch traces through Adafruit_CAP1188_Gestures
+ *  and measures recognition latency: the time from the touch change that
+ *  completes a gesture, a release or the start of a long press, to the
+ *  frame the gesture is reported in. Taps include the double tap gap and
+ *  long presses the long press time, which the recognizer has to wait out.
+ *
+ *  Without arguments, a built-in trace of taps, a double tap, a long press
+ *  and swipes both ways is sampled at several polling periods, and every
+ *  expected gesture must be reported within its wait plus two periods: one
+ *  to see the touch change, one to see the wait run out. A second trace is
+ *  fed one update per touch change only, and a wait that ran out between
+ *  updates must still end its gesture before the change. With a capture
+ *  file written with Adafruit_CAP1188_CaptureEncoder, the touched bytes of
+ *  its frames are replayed on groups of the given input masks, inputs 1-4
+ *  and 5-8 by default. Latency then runs from the first frame showing the
+ *  change.
+ *
+ *  Build and run from extras/ with:
+ *    make check
+ *
+ *  Usage: cap1188_gesture_replay
+ *         cap1188_gesture_replay capture.bin [mask...]
+ *
+ *  Exits with 1 if the built-in trace is not recognized as expected.
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_CAP1188_Capture.h"
+#include "Adafruit_CAP1188_Gestures.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TAP_TIME 250
+#define DOUBLE_TAP_GAP 300
+#define LONG_PRESS_TIME 800
+
+typedef struct {
+  uint32_t time;   // ms
+  uint8_t touched; // Inputs touched from then on
+} step_t;
+
+typedef struct {
+  cap1188_gesture_t gesture;
+  uint8_t group;
+} expected_t;
+
+// Groups 0 and 1 are inputs 1-4 and 5-8
+static const step_t trace[] = {
+    {1000, 0x01}, {1100, 0x00}, // Tap
+    {2000, 0x02}, {2100, 0x00}, {2250, 0x02}, {2350, 0x00}, // Double tap
+    {3000, 0x04}, {3200, 0x14}, {3300, 0x04}, // Long press, tap on group 1
+    {4200, 0x00},
+    {5000, 0x01}, {5080, 0x03}, {5160, 0x02}, {5240, 0x06}, // Swipe up
+    {5320, 0x04}, {5400, 0x0C}, {5480, 0x08}, {5560, 0x00},
+    {7000, 0x08}, {7080, 0x0C}, {7160, 0x04}, {7240, 0x06}, // Swipe down
+    {7320, 0x02}, {7400, 0x03}, {7480, 0x01}, {7560, 0x00},
+    {9000, 0x00},
+};
+
+static const expected_t expected[] = {
+    {CAP1188_GESTURE_TAP, 0},        {CAP1188_GESTURE_DOUBLE_TAP, 0},
+    {CAP1188_GESTURE_TAP, 1},        {CAP1188_GESTURE_LONG_PRESS, 0},
+    {CAP1188_GESTURE_SWIPE_UP, 0},   {CAP1188_GESTURE_SWIPE_DOWN, 0},
+};
+
+// Updated only when the touch changes, so that the time limits run out
+// between updates and are only seen with the next change
+static const step_t sparse[] = {
+    {0, 0x01}, {100, 0x00}, // Tap
+    {5000, 0x01}, {5100, 0x00}, // Tap, long after the first
+    {6000, 0x00}, {7000, 0x01}, {9000, 0x00}, // Long press
+    {10000, 0x00},
+};
+
+static const expected_t sparseExpected[] = {
+    {CAP1188_GESTURE_TAP, 0},
+    {CAP1188_GESTURE_TAP, 0},
+    {CAP1188_GESTURE_LONG_PRESS, 0},
+};
+
+static const char *const names[] = {"none",       "tap",      "double tap",
+                                    "long press", "swipe up", "swipe down"};
+
+#define STEPS (sizeof(trace) / sizeof(trace[0]))
+#define EXPECTED (sizeof(expected) / sizeof(expected[0]))
+#define GESTURES (sizeof(names) / sizeof(names[0]))
+
+typedef struct {
+  uint32_t count;
+  uint32_t min;
+  uint32_t max;
+  uint32_t sum;
+} latency_t;
+
+// Feeds touch frames to the recognizer and keeps latency statistics
+class Replay {
+public:
+  Replay(const uint8_t *masks, uint8_t groups) {
+    _recognizer.setTiming(TAP_TIME, DOUBLE_TAP_GAP, LONG_PRESS_TIME);
+    for (uint8_t i = 0; i < groups; i++) {
+      _masks[i] = masks[i];
+      _edge[i] = 0;
+      _recognizer.addGroup(masks[i]);
+    }
+    _groups = groups;
+    _touched = 0;
+    _reported = 0;
+    for (uint8_t g = 0; g < GESTURES; g++) {
+      _latency[g].count = _latency[g].sum = _latency[g].max = 0;
+      _latency[g].min = 0xFFFFFFFF;
+    }
+  }
+
+  // Records when the touched inputs changed, for the latency
+  void change(uint8_t touched, uint32_t time) {
+    for (uint8_t i = 0; i < _groups; i++) {
+      if ((touched ^ _touched) & _masks[i])
+        _edge[i] = time;
+    }
+    _touched = touched;
+  }
+
+  // Returns the number of gestures written to events
+  uint8_t frame(uint8_t touched, uint32_t now,
+                cap1188_gesture_event_t events[2 * CAP1188_GESTURE_GROUPS]) {
+    change(touched, now);
+    uint8_t count =
+        _recognizer.update(touched, now, events, 2 * CAP1188_GESTURE_GROUPS);
+    for (uint8_t e = 0; e < count; e++) {
+      latency_t *l = &_latency[events[e].gesture];
+      uint32_t latency = now - _edge[events[e].group];
+      l->count++;
+      l->sum += latency;
+      l->min = latency < l->min ? latency : l->min;
+      l->max = latency > l->max ? latency : l->max;
+    }
+    _reported += count;
+    return count;
+  }
+
+  uint32_t edge(uint8_t group) const { return _edge[group]; }
+
+  void report(const char *title) const {
+    printf("%s: %u gestures\n", title, (unsigned)_reported);
+    for (uint8_t g = 1; g < GESTURES; g++) {
+      const latency_t *l = &_latency[g];
+      if (l->count) {
+        printf("  %-10s %5u  latency ms min %5u mean %5u max %5u\n", names[g],
+               (unsigned)l->count, (unsigned)l->min,
+               (unsigned)(l->sum / l->count), (unsigned)l->max);
+      }
+    }
+  }
+
+private:
+  Adafruit_CAP1188_Gestures _recognizer;
+  uint8_t _masks[CAP1188_GESTURE_GROUPS];
+  uint32_t _edge[CAP1188_GESTURE_GROUPS]; // Last change within each group
+  uint8_t _groups;
+  uint8_t _touched;
+  uint32_t _reported;
+  latency_t _latency[GESTURES];
+};
+
+// Longest a gesture may take after the touch change that completes it
+static uint32_t allowed(cap1188_gesture_t gesture, uint32_t period) {
+  if (gesture == CAP1188_GESTURE_TAP)
+    return DOUBLE_TAP_GAP + 2 * period;
+  if (gesture == CAP1188_GESTURE_LONG_PRESS)
+    return LONG_PRESS_TIME + 2 * period;
+  return period;
+}
+
+// Samples the built-in trace every period ms, as a polling loop would
+static bool replayTrace(uint32_t period) {
+  static const uint8_t masks[2] = {0x0F, 0xF0};
+  Replay replay(masks, 2);
+  size_t step = 0, next = 0;
+  uint8_t touched = 0;
+  bool ok = true;
+  for (uint32_t now = 0; now <= trace[STEPS - 1].time; now += period) {
+    while (step < STEPS && trace[step].time <= now) {
+      touched = trace[step].touched;
+      replay.change(touched, trace[step++].time);
+    }
+    cap1188_gesture_event_t events[2 * CAP1188_GESTURE_GROUPS];
+    uint8_t count = replay.frame(touched, now, events);
+    for (uint8_t e = 0; e < count; e++) {
+      const cap1188_gesture_event_t *event = &events[e];
+      uint32_t latency = now - replay.edge(event->group);
+      if (next >= EXPECTED || event->gesture != expected[next].gesture ||
+          event->group != expected[next].group) {
+        printf("unexpected %s on group %u at %u ms\n", names[event->gesture],
+               event->group, (unsigned)now);
+        ok = false;
+      } else if (latency > allowed(event->gesture, period)) {
+        printf("%s on group %u took %u ms\n", names[event->gesture],
+               event->group, (unsigned)latency);
+        ok = false;
+      }
+      next++;
+    }
+  }
+  if (next < EXPECTED) {
+    printf("missed %s on group %u\n", names[expected[next].gesture],
+           expected[next].group);
+    ok = false;
+  }
+  char title[40];
+  snprintf(title, sizeof(title), "built-in trace, %u ms polling",
+           (unsigned)period);
+  replay.report(title);
+  return ok;
+}
+
+// Feeds the sparse trace one update per step
+static bool replaySparse() {
+  static const uint8_t mask = 0x0F;
+  Replay replay(&mask, 1);
+  const size_t steps = sizeof(sparse) / sizeof(sparse[0]);
+  const size_t expect = sizeof(sparseExpected) / sizeof(sparseExpected[0]);
+  size_t next = 0;
+  bool ok = true;
+  for (size_t step = 0; step < steps; step++) {
+    cap1188_gesture_event_t events[2 * CAP1188_GESTURE_GROUPS];
+    uint8_t count =
+        replay.frame(sparse[step].touched, sparse[step].time, events);
+    for (uint8_t e = 0; e < count; e++) {
+      if (next >= expect || events[e].gesture != sparseExpected[next].gesture) {
+        printf("sparse updates: unexpected %s at %u ms\n",
+               names[events[e].gesture], (unsigned)sparse[step].time);
+        ok = false;
+      }
+      next++;
+    }
+  }
+  if (next < expect) {
+    printf("sparse updates: missed %s\n", names[sparseExpected[next].gesture]);
+    ok = false;
+  }
+  replay.report("sparse updates");
+  return ok;
+}
+
+static int replayCapture(const char *path, const uint8_t *masks,
+                         uint8_t groups) {
+  FILE *f = fopen(path, "rb");
+  if (!f) {
+    perror(path);
+    return 2;
+  }
+  static uint8_t data[1 << 20];
+  size_t len = fread(data, 1, sizeof(data), f);
+  fclose(f);
+
+  Adafruit_CAP1188_CaptureDecoder decoder;
+  size_t pos = decoder.header(data, len);
+  if (!pos) {
+    fprintf(stderr, "%s: not a CAP1188 capture\n", path);
+    return 2;
+  }
+  Replay replay(masks, groups);
+  while (pos < len) {
+    cap1188_frame_t frame;
+    size_t used = decoder.decode(data + pos, len - pos, &frame);
+    if (!used) {
+      fprintf(stderr, "%s: truncated or corrupt frame at offset %zu\n", path,
+              pos);
+      break;
+    }
+    pos += used;
+    if (!decoder.synced())
+      continue;
+    cap1188_gesture_event_t events[2 * CAP1188_GESTURE_GROUPS];
+    uint32_t now = frame.time / 1000;
+    uint8_t count = replay.frame(frame.touched, now, events);
+    for (uint8_t e = 0; e < count; e++) {
+      printf("%10u ms  group %u  %s\n", (unsigned)now, events[e].group,
+             names[events[e].gesture]);
+    }
+  }
+  replay.report(path);
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  if (argc > 1) {
+    uint8_t masks[CAP1188_GESTURE_GROUPS] = {0x0F, 0xF0};
+    uint8_t groups = 2;
+    if (argc > 2) {
+      groups = 0;
+      for (int i = 2; i < argc && groups < CAP1188_GESTURE_GROUPS; i++)
+        masks[groups++] = strtoul(argv[i], NULL, 0);
+    }
+    return replayCapture(argv[1], masks, groups);
+  }
+
+  static const uint32_t periods[] = {10, 35, 70};
+  bool ok = true;
+  for (size_t i = 0; i < sizeof(periods) / sizeof(periods[0]); i++) {
+    ok = replayTrace(periods[i]) && ok;
+  }
+  ok = replaySparse() && ok;
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
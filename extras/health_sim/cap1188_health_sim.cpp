@@ -0,0 +1,105 @@
+/*!
+ *  @file cap1188_health_sim.cpp
+ *
+ *  Host simulation of the CAP1188 driver's health check against the
+ *  simulated sensor, over I2C and over SPI. A sketch polls touched() once per
+ *  sensing cycle with setHealthCheck() on, and the sensor is power cycled
+ *  mid-run, losing its configuration. checkHealth() must see the reset
+ *  within one check interval and restoreConfig() must put every register
+ *  back as it was, in the same poll, without seeing resets that did not
+ *  happen. Prints how long detection took and what restoring cost.
+ *
+ *  Build and run from extras/ with:
+ *    make check
+ *
+ *  Exits with 1 if a reset is missed, seen twice or not fully restored.
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_CAP1188.h"
+#include "cap1188_sim.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define POLL_US 35000 // touched() once per sensing cycle
+#define HEALTH_POLLS 20
+#define POLLS_BEFORE 100 // Polls before the power cycle
+#define POLLS_AFTER 100  // Polls after it, to check for false resets
+
+static bool fail(const char *what, bool spi) {
+  printf("FAIL: %s over %s\n", what, spi ? "SPI" : "I2C");
+  return false;
+}
+
+static bool run(bool spi, uint32_t phase) {
+  Adafruit_CAP1188 i2cCap;
+  Adafruit_CAP1188 spiCap(10, -1);
+  Adafruit_CAP1188 *cap = spi ? &spiCap : &i2cCap;
+  cap1188Sim.powerOn();
+  if (!cap->begin()) {
+    return fail("begin() failed", spi);
+  }
+  // Settings the power cycle loses
+  static const uint8_t thresholds[8] = {0x20, 0x28, 0x30, 0x38,
+                                        0x40, 0x48, 0x50, 0x58};
+  cap->setThresholds(thresholds);
+  cap->setInputEnable(0x7F);
+  cap->setSensitivity(CAP1188_SENSITIVITY_64X);
+  cap->setHealthCheck(HEALTH_POLLS);
+  uint8_t configured[256];
+  memcpy(configured, cap1188Sim.regs, sizeof(configured));
+
+  for (uint32_t i = 0; i < POLLS_BEFORE + phase; i++) {
+    cap1188Sim.advance(POLL_US);
+    cap->touched();
+  }
+  cap1188Sim.powerOn();
+  uint32_t polls = 0;
+  while (cap->resetCount() == 0 && polls < 2 * HEALTH_POLLS) {
+    cap1188Sim.advance(POLL_US);
+    cap1188Sim.resetTraffic();
+    cap->touched();
+    polls++;
+  }
+  if (cap->resetCount() == 0) {
+    return fail("power cycle not detected", spi);
+  }
+  if (polls > HEALTH_POLLS) {
+    return fail("power cycle detected later than one check interval", spi);
+  }
+  if (memcmp(configured, cap1188Sim.regs, sizeof(configured)) != 0) {
+    return fail("configuration not restored", spi);
+  }
+  cap1188_bus_stats_t cost = {cap1188Sim.transactions, cap1188Sim.bytes,
+                              cap1188Sim.bytes * (spi ? 8 : 9) +
+                                  cap1188Sim.conditions};
+  // The traffic of the poll that detected the reset and restored the sensor
+  printf("%s, power cycle %2u polls after a check: detected after %2u polls "
+         "(%3u ms), restoring poll %u transactions, %u bytes, %u us\n",
+         spi ? "SPI" : "I2C", (unsigned)phase, (unsigned)polls,
+         (unsigned)(polls * POLL_US / 1000), (unsigned)cost.transactions,
+         (unsigned)cost.bytes,
+         (unsigned)Adafruit_CAP1188::wireTime(&cost, spi ? 2000000 : 400000));
+
+  for (uint32_t i = 0; i < POLLS_AFTER; i++) {
+    cap1188Sim.advance(POLL_US);
+    cap->touched();
+  }
+  if (cap->resetCount() != 1) {
+    return fail("reset seen that did not happen", spi);
+  }
+  return true;
+}
+
+int main() {
+  bool ok = true;
+  for (int spi = 0; spi < 2; spi++) {
+    // Power cycles just after and just before a check
+    ok = run(spi, 1) && ok;
+    ok = run(spi, HEALTH_POLLS - 1) && ok;
+  }
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,37 @@
+/*!
+ *  @file Adafruit_I2CDevice.h
+ *
+ *  The Adafruit BusIO I2C device API used by the CAP1188 library, on a Linux
+ *  host. Transactions go to the simulated sensor in cap1188_sim.h and are
+ *  split the way BusIO splits them.
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef CAP1188_HOST_I2CDEVICE_H
+#define CAP1188_HOST_I2CDEVICE_H
+
+#include <Wire.h>
+
+/*!
+ *    @brief  A device on an I2C bus
+ */
+class Adafruit_I2CDevice {
+public:
+  Adafruit_I2CDevice(uint8_t addr, TwoWire *theWire = &Wire);
+
+  bool begin(bool addr_detect = true);
+  bool detected();
+  bool read(uint8_t *buffer, size_t len, bool stop = true);
+  bool write(const uint8_t *buffer, size_t len, bool stop = true,
+             const uint8_t *prefix_buffer = NULL, size_t prefix_len = 0);
+  bool write_then_read(const uint8_t *write_buffer, size_t write_len,
+                       uint8_t *read_buffer, size_t read_len,
+                       bool stop = false);
+  size_t maxBufferSize();
+
+private:
+  uint8_t _addr;
+};
+
+#endif
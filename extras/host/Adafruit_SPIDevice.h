@@ -0,0 +1,44 @@
+/*!
+ *  @file Adafruit_SPIDevice.h
+ *
+ *  The Adafruit BusIO SPI device API used by the CAP1188 library, on a Linux
+ *  host. Transactions go to the simulated sensor in cap1188_sim.h.
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef CAP1188_HOST_SPIDEVICE_H
+#define CAP1188_HOST_SPIDEVICE_H
+
+#include <SPI.h>
+
+/*!
+ *    @brief  Bit order on the wire
+ */
+typedef enum {
+  SPI_BITORDER_MSBFIRST, ///< Most significant bit first
+  SPI_BITORDER_LSBFIRST, ///< Least significant bit first
+} BusIOBitOrder;
+
+/*!
+ *    @brief  A device on an SPI bus
+ */
+class Adafruit_SPIDevice {
+public:
+  Adafruit_SPIDevice(int8_t cspin, uint32_t freq = 1000000,
+                     BusIOBitOrder dataOrder = SPI_BITORDER_MSBFIRST,
+                     uint8_t dataMode = SPI_MODE0, SPIClass *theSPI = &SPI);
+  Adafruit_SPIDevice(int8_t cspin, int8_t sck, int8_t miso, int8_t mosi,
+                     uint32_t freq = 1000000,
+                     BusIOBitOrder dataOrder = SPI_BITORDER_MSBFIRST,
+                     uint8_t dataMode = SPI_MODE0);
+
+  bool begin();
+  bool write(const uint8_t *buffer, size_t len,
+             const uint8_t *prefix_buffer = NULL, size_t prefix_len = 0);
+  bool write_then_read(const uint8_t *write_buffer, size_t write_len,
+                       uint8_t *read_buffer, size_t read_len,
+                       uint8_t sendvalue = 0xFF);
+};
+
+#endif
@@ -0,0 +1,38 @@
+/*!
+ *  @file Arduino.h
+ *
+ *  The part of the Arduino API used by the CAP1188 library, for building it
+ *  on a Linux host against the simulated sensor in cap1188_sim.h. Time is
+ *  simulated too and only advances through delay(), delayMicroseconds() or
+ *  cap1188Sim.advance().
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef CAP1188_HOST_ARDUINO_H
+#define CAP1188_HOST_ARDUINO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef bool boolean; ///< Arduino's name for bool
+
+#define LOW 0          ///< Pin level
+#define HIGH 1         ///< Pin level
+#define INPUT 0        ///< Pin mode
+#define OUTPUT 1       ///< Pin mode
+#define INPUT_PULLUP 2 ///< Pin mode
+#define FALLING 2      ///< Interrupt mode
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void noInterrupts();
+void interrupts();
+
+#endif
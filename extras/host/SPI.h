@@ -0,0 +1,24 @@
+/*!
+ *  @file SPI.h
+ *
+ *  Stand-in for the Arduino SPI library on a Linux host. The bus itself is
+ *  simulated by the Adafruit_SPIDevice in cap1188_sim.cpp.
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef CAP1188_HOST_SPI_H
+#define CAP1188_HOST_SPI_H
+
+#include "Arduino.h"
+
+#define SPI_MODE0 0 ///< Clock idle low, data sampled on the rising edge
+
+/*!
+ *    @brief  An SPI bus
+ */
+class SPIClass {};
+
+extern SPIClass SPI; ///< Default SPI bus
+
+#endif
@@ -0,0 +1,22 @@
+/*!
+ *  @file Wire.h
+ *
+ *  Stand-in for the Arduino Wire library on a Linux host. The bus itself is
+ *  simulated by the Adafruit_I2CDevice in cap1188_sim.cpp.
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef CAP1188_HOST_WIRE_H
+#define CAP1188_HOST_WIRE_H
+
+#include "Arduino.h"
+
+/*!
+ *    @brief  An I2C bus
+ */
+class TwoWire {};
+
+extern TwoWire Wire; ///< Default I2C bus
+
+#endif
@@ -0,0 +1,364 @@
+/*!
+ *  @file cap1188_sim.cpp
+ *
+ *  Simulated CAP1188, and the Arduino and BusIO functions of the host shim
+ *  that drive it
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#include "cap1188_sim.h"
+
+#include "Adafruit_CAP1188.h"
+
+// SPI commands
+#define SPI_SET_ADDRESS 0x7D ///< Next byte is the register
+#define SPI_WRITE_DATA 0x7E  ///< Next byte is stored, the pointer advances
+#define SPI_READ_DATA 0x7F   ///< Next byte out is the register, which
+                             ///< advances the pointer
+
+CAP1188Sim cap1188Sim;
+TwoWire Wire;
+SPIClass SPI;
+
+/*!
+ *    @brief  Instantiates a sensor that has just been powered on
+ */
+CAP1188Sim::CAP1188Sim() {
+  address = CAP1188_I2CADDR;
+  present = true;
+  resetPin = -1;
+  held = false;
+  awake = 0;
+  i2cBuffer = 32;
+  time = 0;
+  powerOn();
+  resetTraffic();
+}
+
+/*!
+ *    @brief  Puts the registers back to their power-on values
+ */
+void CAP1188Sim::powerOn() {
+  memset(regs, 0, sizeof(regs));
+  regs[CAP1188_SENSITIVITY] = 0x2F;
+  regs[0x20] = 0x20; // Configuration
+  regs[CAP1188_SENINPUTEN] = 0xFF;
+  regs[0x22] = 0xA4; // Sensor Input Configuration
+  regs[0x23] = 0x07; // Sensor Input Configuration 2
+  regs[CAP1188_AVGSAMPLE] = 0x39;
+  regs[CAP1188_INTENABLE] = 0xFF;
+  regs[CAP1188_REPEATEN] = 0xFF;
+  regs[CAP1188_MTBLK] = 0x80;
+  regs[CAP1188_RECALCFG] = 0x8A;
+  for (uint8_t i = 0; i < 8; i++) {
+    regs[CAP1188_THRESH1 + i] = 0x40;
+  }
+  regs[CAP1188_NOISETHRESH] = 0x01;
+  regs[CAP1188_STANDBYCFG] = CAP1188_STANDBYCFG_DEFAULT;
+  regs[CAP1188_CONFIG2] = 0x40;
+  regs[CAP1188_PRODID] = 0x50;
+  regs[CAP1188_MANUID] = 0x5D;
+  regs[CAP1188_REV] = 0x83;
+  pointer = 0;
+  touching = 0;
+  _written = 0;
+  _spiState = 0;
+  _spiOut = -1;
+}
+
+/*!
+ *    @brief  Changes the inputs being touched. A press, or a release with
+ *            release interrupts enabled, asserts the interrupt; the input
+ *            status keeps every touch seen until the interrupt is cleared.
+ *    @param  inputs
+ *            inputs touched from now on, bit 0 is input 1
+ */
+void CAP1188Sim::touch(uint8_t inputs) {
+  inputs &= regs[CAP1188_SENINPUTEN];
+  uint8_t pressed = inputs & ~touching;
+  uint8_t released = touching & ~inputs;
+  touching = inputs;
+  regs[CAP1188_SENINPUTSTATUS] |= inputs;
+  regs[CAP1188_GENSTATUS] = (regs[CAP1188_GENSTATUS] & ~0x01) |
+                            (inputs ? CAP1188_GENSTATUS_TOUCH : 0);
+  bool onRelease = !(regs[CAP1188_CONFIG2] & CAP1188_CONFIG2_INT_REL_N);
+  if ((pressed | (onRelease ? released : 0)) & regs[CAP1188_INTENABLE]) {
+    regs[CAP1188_MAIN] |= CAP1188_MAIN_INT;
+  }
+}
+
+/*!
+ *    @brief  Clears the traffic counters
+ */
+void CAP1188Sim::resetTraffic() {
+  transactions = 0;
+  bytes = 0;
+  conditions = 0;
+}
+
+/*!
+ *    @brief  Gets the state of the ALERT pin
+ *    @return True while the interrupt is asserted
+ */
+bool CAP1188Sim::alert() const { return regs[CAP1188_MAIN] & CAP1188_MAIN_INT; }
+
+/*!
+ *    @brief  Checks whether the sensor takes part in bus transactions
+ *    @return True if it is present and out of reset
+ */
+bool CAP1188Sim::answering() const {
+  return present && !held && (int32_t)(time - awake) >= 0;
+}
+
+/*!
+ *    @brief  Stores a value at the address pointer and advances it
+ *    @param  value
+ *            value written by the host
+ */
+void CAP1188Sim::store(uint8_t value) {
+  if (pointer == CAP1188_CALACTIVE) {
+    // Calibration completes at once
+    value = 0;
+  }
+  if (pointer == CAP1188_MAIN && !(value & CAP1188_MAIN_INT)) {
+    // Clearing the interrupt drops the latched touches
+    regs[CAP1188_SENINPUTSTATUS] = touching;
+  }
+  regs[pointer++] = value;
+}
+
+/*!
+ *    @brief  Starts or restarts an I2C transaction
+ *    @param  addr
+ *            7-bit address the host sends
+ *    @return True if the sensor acknowledged
+ */
+bool CAP1188Sim::i2cStart(uint8_t addr) {
+  conditions++;
+  bytes++;
+  _written = 0;
+  return answering() && addr == address;
+}
+
+/*!
+ *    @brief  Writes the data phase of an I2C write. The first byte sets the
+ *            address pointer, the others are stored from there.
+ *    @param  data
+ *            bytes sent by the host
+ *    @param  len
+ *            number of bytes
+ */
+void CAP1188Sim::i2cWrite(const uint8_t *data, size_t len) {
+  bytes += len;
+  for (size_t i = 0; i < len; i++) {
+    if (_written++ == 0) {
+      pointer = _first = data[i];
+    } else {
+      store(data[i]);
+    }
+  }
+}
+
+/*!
+ *    @brief  Reads the data phase of an I2C read. A block read advances the
+ *            address pointer, a single byte read leaves it.
+ *    @param  data
+ *            filled with the bytes sent by the sensor
+ *    @param  len
+ *            number of bytes
+ */
+void CAP1188Sim::i2cRead(uint8_t *data, size_t len) {
+  bytes += len;
+  for (size_t i = 0; i < len; i++) {
+    data[i] = regs[(uint8_t)(pointer + i)];
+  }
+  if (len > 1) {
+    pointer += len;
+  }
+}
+
+/*!
+ *    @brief  Ends an I2C transaction
+ */
+void CAP1188Sim::i2cStop() {
+  conditions++;
+  transactions++;
+  if (_written == 2) {
+    // A single register write leaves the pointer on the register
+    pointer = _first;
+  }
+  _written = 0;
+}
+
+/*!
+ *    @brief  Selects the sensor on the SPI bus
+ */
+void CAP1188Sim::spiSelect() {
+  _spiState = 0;
+  _spiOut = -1;
+}
+
+/*!
+ *    @brief  Exchanges one byte over SPI
+ *    @param  out
+ *            byte sent by the host
+ *    @return Byte sent by the sensor
+ */
+uint8_t CAP1188Sim::spiTransfer(uint8_t out) {
+  bytes++;
+  if (!answering()) {
+    return 0xFF;
+  }
+  uint8_t in = _spiOut >= 0 ? _spiOut : 0;
+  _spiOut = -1;
+  if (_spiState == SPI_SET_ADDRESS) {
+    pointer = out;
+    _spiState = 0;
+  } else if (_spiState == SPI_WRITE_DATA) {
+    store(out);
+    _spiState = 0;
+  } else if (out == SPI_READ_DATA) {
+    _spiOut = regs[pointer++];
+  } else if (out == SPI_SET_ADDRESS || out == SPI_WRITE_DATA) {
+    _spiState = out;
+  }
+  return in;
+}
+
+/*!
+ *    @brief  Deselects the sensor, ending an SPI transaction
+ */
+void CAP1188Sim::spiDeselect() { transactions++; }
+
+void pinMode(uint8_t, uint8_t) {}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  if (pin != cap1188Sim.resetPin) {
+    return;
+  }
+  if (value == HIGH) {
+    cap1188Sim.held = true;
+  } else if (cap1188Sim.held) {
+    // Leaving reset starts over from the power-on state, after the 15 ms
+    // communications delay
+    cap1188Sim.held = false;
+    cap1188Sim.awake = cap1188Sim.time + 15000;
+    cap1188Sim.powerOn();
+  }
+}
+
+// Every input pin is taken to be the ALERT pin, which is active low
+int digitalRead(uint8_t) { return cap1188Sim.alert() ? LOW : HIGH; }
+
+unsigned long millis() { return cap1188Sim.time / 1000; }
+
+unsigned long micros() { return cap1188Sim.time; }
+
+void delay(unsigned long ms) { cap1188Sim.advance(ms * 1000); }
+
+void delayMicroseconds(unsigned int us) { cap1188Sim.advance(us); }
+
+void noInterrupts() {}
+
+void interrupts() {}
+
+Adafruit_I2CDevice::Adafruit_I2CDevice(uint8_t addr, TwoWire *) {
+  _addr = addr;
+}
+
+bool Adafruit_I2CDevice::begin(bool addr_detect) {
+  return !addr_detect || detected();
+}
+
+bool Adafruit_I2CDevice::detected() {
+  bool ack = cap1188Sim.i2cStart(_addr);
+  cap1188Sim.i2cStop();
+  return ack;
+}
+
+// Like BusIO, reads longer than the buffer are split into chunks, each after
+// a repeated start
+bool Adafruit_I2CDevice::read(uint8_t *buffer, size_t len, bool stop) {
+  size_t pos = 0;
+  while (pos < len) {
+    size_t chunk = len - pos;
+    if (chunk > maxBufferSize()) {
+      chunk = maxBufferSize();
+    }
+    if (!cap1188Sim.i2cStart(_addr)) {
+      cap1188Sim.i2cStop();
+      return false;
+    }
+    cap1188Sim.i2cRead(buffer + pos, chunk);
+    pos += chunk;
+  }
+  if (stop) {
+    cap1188Sim.i2cStop();
+  }
+  return true;
+}
+
+// Like BusIO, writes that do not fit the buffer are refused
+bool Adafruit_I2CDevice::write(const uint8_t *buffer, size_t len, bool stop,
+                               const uint8_t *prefix_buffer,
+                               size_t prefix_len) {
+  if (len + prefix_len > maxBufferSize()) {
+    return false;
+  }
+  bool ack = cap1188Sim.i2cStart(_addr);
+  if (ack) {
+    cap1188Sim.i2cWrite(prefix_buffer, prefix_len);
+    cap1188Sim.i2cWrite(buffer, len);
+  }
+  if (stop || !ack) {
+    cap1188Sim.i2cStop();
+  }
+  return ack;
+}
+
+bool Adafruit_I2CDevice::write_then_read(const uint8_t *write_buffer,
+                                         size_t write_len,
+                                         uint8_t *read_buffer,
+                                         size_t read_len, bool stop) {
+  return write(write_buffer, write_len, stop) && read(read_buffer, read_len);
+}
+
+size_t Adafruit_I2CDevice::maxBufferSize() { return cap1188Sim.i2cBuffer; }
+
+Adafruit_SPIDevice::Adafruit_SPIDevice(int8_t, uint32_t, BusIOBitOrder,
+                                       uint8_t, SPIClass *) {}
+
+Adafruit_SPIDevice::Adafruit_SPIDevice(int8_t, int8_t, int8_t, int8_t,
+                                       uint32_t, BusIOBitOrder, uint8_t) {}
+
+bool Adafruit_SPIDevice::begin() { return true; }
+
+bool Adafruit_SPIDevice::write(const uint8_t *buffer, size_t len,
+                               const uint8_t *prefix_buffer,
+                               size_t prefix_len) {
+  cap1188Sim.spiSelect();
+  for (size_t i = 0; i < prefix_len; i++) {
+    cap1188Sim.spiTransfer(prefix_buffer[i]);
+  }
+  for (size_t i = 0; i < len; i++) {
+    cap1188Sim.spiTransfer(buffer[i]);
+  }
+  cap1188Sim.spiDeselect();
+  return true;
+}
+
+bool Adafruit_SPIDevice::write_then_read(const uint8_t *write_buffer,
+                                         size_t write_len,
+                                         uint8_t *read_buffer,
+                                         size_t read_len, uint8_t sendvalue) {
+  cap1188Sim.spiSelect();
+  for (size_t i = 0; i < write_len; i++) {
+    cap1188Sim.spiTransfer(write_buffer[i]);
+  }
+  for (size_t i = 0; i < read_len; i++) {
+    read_buffer[i] = cap1188Sim.spiTransfer(sendvalue);
+  }
+  cap1188Sim.spiDeselect();
+  return true;
+}
@@ -0,0 +1,73 @@
+/*!
+ *  @file cap1188_sim.h
+ *
+ *  Simulated CAP1188 behind the host Arduino and BusIO shim, for running the
+ *  library's tools, tests and benchmarks without hardware.
+ *
+ *  The register file, the address pointer and the I2C and SPI protocols
+ *  behave like the sensor's. While RESET is driven high the sensor does not
+ *  answer, and once released it powers on again and answers after its
+ *  communications delay. Touches latch the input status and assert the
+ *  interrupt until it is cleared, the ALERT pin follows the interrupt, and
+ *  calibration completes at once. Wire traffic is counted here independently
+ *  of the driver's own accounting, so that tools can check one against the
+ *  other.
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#ifndef CAP1188_SIM_H
+#define CAP1188_SIM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*!
+ *    @brief  A simulated sensor and its bus traffic
+ */
+class CAP1188Sim {
+public:
+  CAP1188Sim();
+
+  void powerOn();
+  void touch(uint8_t inputs);
+  void advance(uint32_t us) { time += us; } ///< Lets simulated time pass
+  void resetTraffic();
+  bool alert() const;
+
+  // Bus side, driven by the BusIO shim
+  bool i2cStart(uint8_t addr);
+  void i2cWrite(const uint8_t *data, size_t len);
+  void i2cRead(uint8_t *data, size_t len);
+  void i2cStop();
+  void spiSelect();
+  uint8_t spiTransfer(uint8_t out);
+  void spiDeselect();
+
+  uint8_t regs[256];    ///< Register file
+  uint8_t pointer;      ///< Register the address pointer is on
+  uint8_t address;      ///< I2C address the sensor answers on
+  bool present;         ///< The sensor answers on the bus
+  int16_t resetPin;     ///< Pin wired to RESET, -1 if none
+  bool held;            ///< RESET is high, the sensor is held in reset
+  uint32_t awake;       ///< Simulated time it answers again from
+  uint8_t touching;     ///< Inputs being touched
+  size_t i2cBuffer;     ///< BusIO buffer size, 32 bytes as on AVR
+  uint32_t time;        ///< Simulated micros()
+  uint32_t transactions; ///< Transactions seen
+  uint32_t bytes;        ///< Bytes seen, including address and command bytes
+  uint32_t conditions;   ///< I2C start, repeated start and stop conditions
+
+private:
+  void store(uint8_t value);
+  bool answering() const;
+
+  uint8_t _written;  ///< Bytes written since the last I2C start
+  uint8_t _first;    ///< Register the current I2C write started at
+  uint8_t _spiState; ///< SPI command awaiting its argument
+  int16_t _spiOut;   ///< Byte to shift out next over SPI, -1 if none
+};
+
+extern CAP1188Sim cap1188Sim; ///< The sensor behind the shim
+
+#endif
@@ -0,0 +1,85 @@
+/*!
+ *  @file cap1188_interrupt_sim.cpp
+ *
+ *  Host simulation of the CAP1188 driver's interrupt policies against the
+ *  simulated sensor, whose input status latches until the interrupt is
+ *  cleared. Presses and releases are read through both touched() and
+ *  readSnapshot(), with release interrupts and without them. A release must
+ *  be reported by the read that clears its interrupt, and with
+ *  CAP1188_INT_PRESS, where a release raises no interrupt, by the first read
+ *  after it while the held input is polled.
+ *
+ *  Build and run from extras/ with:
+ *    make check
+ *
+ *  Exits with 1 if a read reports the wrong touch status.
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_CAP1188.h"
+#include "cap1188_sim.h"
+
+#include <stdio.h>
+
+static const char *const policies[] = {"press", "press and release"};
+
+// Reads the touch status the way the case under test does
+static uint8_t readTouched(Adafruit_CAP1188 *cap, bool snapshot) {
+  if (!snapshot)
+    return cap->touched();
+  cap1188_snapshot_t s;
+  return cap->readSnapshot(&s) ? s.touched : 0xEE;
+}
+
+// Runs presses and releases with one policy through one kind of read
+static bool run(cap1188_int_policy_t policy, bool snapshot) {
+  Adafruit_CAP1188 cap;
+  cap1188Sim.powerOn();
+  if (!cap.begin()) {
+    printf("begin() failed\n");
+    return false;
+  }
+  cap.setInterruptPolicy(policy);
+
+  static const struct {
+    uint8_t touching;
+    uint8_t expected; // Touch status the next read must report
+    const char *what;
+  } steps[] = {
+      {0x01, 0x01, "press"},
+      {0x01, 0x01, "held"},
+      {0x01, 0x01, "held again"},
+      {0x03, 0x03, "second press"},
+      {0x02, 0x02, "release of one"},
+      {0x02, 0x02, "other held"},
+      {0x00, 0x00, "release of all"},
+      {0x00, 0x00, "idle"},
+      {0x04, 0x04, "press"},
+      {0x00, 0x00, "release after a single read"},
+  };
+
+  bool ok = true;
+  for (size_t i = 0; i < sizeof(steps) / sizeof(steps[0]); i++) {
+    cap1188Sim.touch(steps[i].touching);
+    cap1188Sim.advance(35000);
+    uint8_t touched = readTouched(&cap, snapshot);
+    if (touched != steps[i].expected) {
+      printf("FAIL: %s, %s: %s read 0x%02X, expected 0x%02X\n",
+             policies[policy], snapshot ? "readSnapshot()" : "touched()",
+             steps[i].what, touched, steps[i].expected);
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+int main() {
+  bool ok = true;
+  for (int snapshot = 0; snapshot < 2; snapshot++) {
+    ok = run(CAP1188_INT_PRESS, snapshot) && ok;
+    ok = run(CAP1188_INT_PRESS_RELEASE, snapshot) && ok;
+  }
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
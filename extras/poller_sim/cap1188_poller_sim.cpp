@@ -0,0 +1,170 @@
+/*!
+ *  @file cap1188_poller_sim.cpp
+ *
+ *  Host simulation of Adafruit_CAP1188_Poller against polling at a fixed
+ *  interval. The simulated sensor publishes its status once per cycle, at a
+ *  random phase, while touches come and go every 40-440 ms. Latency runs
+ *  from the status update that shows a touch change to the read that sees
+ *  it. The phase-locked poller runs with oscillators from 5% fast to 3%
+ *  slow against the computed cycle time, and micros() wraps mid-run.
+ *
+ *  Build and run from extras/ with:
+ *    make check
+ *
+ *  Exits with 1 if the phase-locked poller needs more reads, locks later or
+ *  has a higher latency than the limits below.
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_CAP1188_Poller.h"
+
+#include <algorithm>
+#include <stdio.h>
+#include <vector>
+
+#define CYCLE 70000          // Computed cycle time, us
+#define STEP 50              // Simulation resolution, us
+#define DURATION 600000000UL // 10 minutes, us
+#define WARMUP 60000000UL    // Not counted in the latency, us
+
+// Limits for the phase-locked poller
+#define MAX_READS_PER_S 25
+#define MAX_MEAN_US 2000
+#define MAX_P95_US 3000
+#define MAX_LOCK_US 20000000UL
+
+static uint32_t seed;
+
+// Small deterministic generator, so that runs reproduce everywhere
+static uint32_t random32() {
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return seed;
+}
+
+typedef struct {
+  double readsPerSecond;
+  double mean; // us
+  uint32_t p50;
+  uint32_t p95;
+  uint32_t max;
+  uint32_t lockTime; // us after the start, 0 if never locked
+} result_t;
+
+// Runs the sensor with cycle time actual; interval 0 polls phase-locked
+static result_t run(uint32_t actual, uint32_t interval, uint32_t runSeed) {
+  seed = runSeed;
+  // Start close to the micros() wrap
+  const uint32_t start = 0xFFFFFFFF - 100000000UL;
+  uint32_t nextUpdate = random32() % actual;
+  uint32_t nextToggle = 50000 + random32() % 300000;
+  uint32_t published = 0; // Time of the update showing the pending change
+  bool raw = false, visible = false, seen = false, pending = false;
+  uint32_t lastRead = 0;
+  unsigned long reads = 0;
+  std::vector<uint32_t> latencies;
+  result_t result = {};
+
+  Adafruit_CAP1188_Poller poller(1000);
+  poller.setCycleTime(CYCLE);
+  for (uint32_t t = 0; t < DURATION; t += STEP) {
+    if (t >= nextToggle) {
+      raw = !raw;
+      nextToggle = t + 40000 + random32() % 400000;
+    }
+    if (t >= nextUpdate) {
+      if (visible != raw) {
+        visible = raw;
+        published = nextUpdate;
+        pending = true;
+      }
+      nextUpdate += actual;
+    }
+
+    bool read;
+    if (interval) {
+      read = !reads || t - lastRead >= interval;
+    } else {
+      read = poller.due(start + t);
+    }
+    if (!read) {
+      continue;
+    }
+    reads++;
+    lastRead = t;
+    bool changed = visible != seen;
+    if (changed && pending) {
+      if (t > WARMUP)
+        latencies.push_back(t - published);
+      pending = false;
+    }
+    seen = visible;
+    if (!interval) {
+      poller.update(changed, start + t);
+      if (!result.lockTime && poller.locked())
+        result.lockTime = t;
+    }
+  }
+
+  std::sort(latencies.begin(), latencies.end());
+  double sum = 0;
+  for (size_t i = 0; i < latencies.size(); i++)
+    sum += latencies[i];
+  result.readsPerSecond = reads / (DURATION / 1e6);
+  result.mean = sum / latencies.size();
+  result.p50 = latencies[latencies.size() / 2];
+  result.p95 = latencies[latencies.size() * 95 / 100];
+  result.max = latencies.back();
+  return result;
+}
+
+static void print(const char *name, const result_t *r) {
+  printf("%-32s %6.1f %7.2f %7.2f %7.2f %7.2f", name, r->readsPerSecond,
+         r->mean / 1000, r->p50 / 1000.0, r->p95 / 1000.0, r->max / 1000.0);
+  if (r->lockTime)
+    printf(" %6.1f s", r->lockTime / 1e6);
+  printf("\n");
+}
+
+int main() {
+  static const struct {
+    const char *name;
+    uint32_t actual;
+  } oscillators[] = {
+      {"phase-locked", CYCLE},
+      {"phase-locked, oscillator +1%", CYCLE * 101 / 100},
+      {"phase-locked, oscillator +3%", CYCLE * 103 / 100},
+      {"phase-locked, oscillator -2%", CYCLE * 98 / 100},
+      {"phase-locked, oscillator -5%", CYCLE * 95 / 100},
+  };
+  static const uint32_t intervals[] = {70000, 35000, 10000};
+
+  bool ok = true;
+  printf("%-32s %6s %7s %7s %7s %7s %8s\n", "polling", "reads/s", "mean",
+         "p50", "p95", "max ms", "locked");
+  for (uint32_t runSeed = 1; runSeed <= 2; runSeed++) {
+    for (size_t i = 0; i < sizeof(oscillators) / sizeof(oscillators[0]);
+         i++) {
+      result_t r = run(oscillators[i].actual, 0, runSeed);
+      print(oscillators[i].name, &r);
+      if (r.readsPerSecond > MAX_READS_PER_S || r.mean > MAX_MEAN_US ||
+          r.p95 > MAX_P95_US || !r.lockTime || r.lockTime > MAX_LOCK_US) {
+        printf("REGRESSION: limits are %u reads/s, mean %u us, p95 %u us, "
+               "locked within %lu s\n",
+               MAX_READS_PER_S, MAX_MEAN_US, MAX_P95_US, MAX_LOCK_US / 1000000);
+        ok = false;
+      }
+    }
+    for (size_t i = 0; i < sizeof(intervals) / sizeof(intervals[0]); i++) {
+      char name[40];
+      snprintf(name, sizeof(name), "every %u ms, oscillator +1%%",
+               (unsigned)(intervals[i] / 1000));
+      result_t r = run(CYCLE * 101 / 100, intervals[i], runSeed);
+      print(name, &r);
+    }
+  }
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,139 @@
+/*!
+ *  @file cap1188_register_dump.cpp
+ *
+ *  Host tool that prints CAP1188 register dumps written with
+ *  Adafruit_CAP1188::dumpRegisters(), or the registers that differ between
+ *  two dumps, e.g. a tuned unit and one that misbehaves.
+ *
+ *  Build from this directory with:
+ *    c++ -O2 -I../.. -o cap1188_register_dump cap1188_register_dump.cpp \
+ *        ../../Adafruit_CAP1188_Dump.cpp
+ *
+ *  Usage: cap1188_register_dump dump.bin
+ *         cap1188_register_dump a.bin b.bin
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_CAP1188_Dump.h"
+
+#include <stdio.h>
+
+typedef struct {
+  uint8_t reg;
+  uint8_t count; // Registers sharing the name, numbered from 1
+  const char *name;
+} register_name_t;
+
+static const register_name_t names[] = {
+    {0x00, 1, "Main Control"},
+    {0x02, 1, "General Status"},
+    {0x03, 1, "Sensor Input Status"},
+    {0x04, 1, "LED Status"},
+    {0x0A, 1, "Noise Flag Status"},
+    {0x10, 8, "Sensor Input %u Delta Count"},
+    {0x1F, 1, "Sensitivity Control"},
+    {0x20, 1, "Configuration"},
+    {0x21, 1, "Sensor Input Enable"},
+    {0x22, 1, "Sensor Input Configuration"},
+    {0x23, 1, "Sensor Input Configuration 2"},
+    {0x24, 1, "Averaging and Sampling Config"},
+    {0x26, 1, "Calibration Activate"},
+    {0x27, 1, "Interrupt Enable"},
+    {0x28, 1, "Repeat Rate Enable"},
+    {0x2A, 1, "Multiple Touch Configuration"},
+    {0x2B, 1, "Multiple Touch Pattern Config"},
+    {0x2D, 1, "Multiple Touch Pattern"},
+    {0x2F, 1, "Recalibration Configuration"},
+    {0x30, 8, "Sensor Input %u Threshold"},
+    {0x38, 1, "Sensor Input Noise Threshold"},
+    {0x40, 1, "Standby Channel"},
+    {0x41, 1, "Standby Configuration"},
+    {0x42, 1, "Standby Sensitivity"},
+    {0x43, 1, "Standby Threshold"},
+    {0x44, 1, "Configuration 2"},
+    {0x50, 8, "Sensor Input %u Base Count"},
+    {0x71, 1, "LED Output Type"},
+    {0x72, 1, "Sensor Input LED Linking"},
+    {0x73, 1, "LED Polarity"},
+    {0x74, 1, "LED Output Control"},
+    {0x77, 1, "Linked LED Transition Control"},
+    {0x79, 1, "LED Mirror Control"},
+    {0x81, 1, "LED Behavior 1"},
+    {0x82, 1, "LED Behavior 2"},
+    {0x84, 1, "LED Pulse 1 Period"},
+    {0x85, 1, "LED Pulse 2 Period"},
+    {0x86, 1, "LED Breathe Period"},
+    {0x88, 1, "LED Config"},
+    {0x90, 1, "LED Pulse 1 Duty Cycle"},
+    {0x91, 1, "LED Pulse 2 Duty Cycle"},
+    {0x92, 1, "LED Breathe Duty Cycle"},
+    {0x93, 1, "LED Direct Duty Cycle"},
+    {0x94, 1, "LED Direct Ramp Rates"},
+    {0x95, 1, "LED Off Delay"},
+    {0xFD, 1, "Product ID"},
+    {0xFE, 1, "Manufacturer ID"},
+    {0xFF, 1, "Revision"},
+};
+
+// Formats the name of a register, returns false for reserved registers
+static bool registerName(uint8_t reg, char *name, size_t size) {
+  for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+    uint8_t index = reg - names[i].reg;
+    if (reg >= names[i].reg && index < names[i].count) {
+      snprintf(name, size, names[i].name, index + 1);
+      return true;
+    }
+  }
+  snprintf(name, size, "(reserved)");
+  return false;
+}
+
+static bool load(const char *path, uint8_t dump[CAP1188_DUMP_SIZE]) {
+  FILE *f = fopen(path, "rb");
+  if (!f) {
+    perror(path);
+    return false;
+  }
+  size_t len = fread(dump, 1, CAP1188_DUMP_SIZE, f);
+  fclose(f);
+  if (!Adafruit_CAP1188_Dump::valid(dump, len)) {
+    fprintf(stderr, "%s: not a valid version %u register dump\n", path,
+            CAP1188_DUMP_VERSION);
+    return false;
+  }
+  return true;
+}
+
+int main(int argc, char **argv) {
+  if (argc != 2 && argc != 3) {
+    fprintf(stderr, "usage: %s dump.bin [other.bin]\n", argv[0]);
+    return 2;
+  }
+  uint8_t a[CAP1188_DUMP_SIZE], b[CAP1188_DUMP_SIZE];
+  bool diff = argc == 3;
+  if (!load(argv[1], a) || (diff && !load(argv[2], b))) {
+    return 2;
+  }
+
+  int differences = 0;
+  for (uint8_t r = 0; r < CAP1188_DUMP_RANGES; r++) {
+    const cap1188_dump_range_t *range = &Adafruit_CAP1188_Dump::ranges[r];
+    for (uint8_t i = 0; i < range->len; i++) {
+      uint8_t reg = range->reg + i;
+      int16_t offset = Adafruit_CAP1188_Dump::offset(reg);
+      char name[40];
+      bool named = registerName(reg, name, sizeof(name));
+      if (!diff) {
+        if (named) {
+          printf("0x%02X  %-32s 0x%02X\n", reg, name, a[offset]);
+        }
+      } else if (a[offset] != b[offset]) {
+        printf("0x%02X  %-32s 0x%02X -> 0x%02X\n", reg, name, a[offset],
+               b[offset]);
+        differences++;
+      }
+    }
+  }
+  return differences ? 1 : 0;
+}
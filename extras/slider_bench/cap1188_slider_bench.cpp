@@ -0,0 +1,110 @@
+/*!
+ *  @file cap1188_slider_bench.cpp
+ *
+ *  Host benchmark of Adafruit_CAP1188_Slider. Checks that a finger swept
+ *  along an eight electrode slider and wheel is located to within a few
+ *  position units, then times update() on the same delta counts and prints
+ *  nanoseconds, and on x86 TSC cycles, per update.
+ *
+ *  Build and run from extras/ with:
+ *    make check
+ *
+ *  Exits with 1 if a position is off. The timings are only reported, since
+ *  they depend on the host.
+ *
+ *  BSD license, all text above must be included in any redistribution
+ */
+
+#include "Adafruit_CAP1188_Slider.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#define TOLERANCE 4 // Position units, from rounding the delta counts
+#define ROUNDS 2000
+
+// Delta counts of a finger at position, falling off linearly to 0 one pitch
+// away from it
+static void finger(int32_t position, bool wheel, int8_t deltas[8]) {
+  int32_t span = 8 * CAP1188_SLIDER_PITCH;
+  for (uint8_t i = 0; i < 8; i++) {
+    int32_t distance = abs(i * CAP1188_SLIDER_PITCH - position);
+    if (wheel && distance > span / 2)
+      distance = span - distance;
+    deltas[i] = distance < CAP1188_SLIDER_PITCH
+                    ? 100 - distance * 100 / CAP1188_SLIDER_PITCH
+                    : 0;
+  }
+}
+
+static bool sweep(bool wheel) {
+  Adafruit_CAP1188_Slider slider(0, 8, wheel);
+  slider.setSmoothing(0);
+  int32_t span = slider.range();
+  for (int32_t p = 0; p < span; p++) {
+    int8_t deltas[8];
+    finger(p, wheel, deltas);
+    if (!slider.update(deltas, p)) {
+      printf("%s: no touch at %d\n", wheel ? "wheel" : "slider", (int)p);
+      return false;
+    }
+    int32_t error = abs(slider.position() - p);
+    if (wheel && error > span / 2)
+      error = span - error;
+    if (slider.position() >= span || error > TOLERANCE) {
+      printf("%s: position %u for a finger at %d\n",
+             wheel ? "wheel" : "slider", slider.position(), (int)p);
+      return false;
+    }
+  }
+  return true;
+}
+
+static uint64_t nanoseconds() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void bench(bool wheel) {
+  static int8_t frames[8 * CAP1188_SLIDER_PITCH][8];
+  Adafruit_CAP1188_Slider slider(0, 8, wheel);
+  uint32_t span = slider.range();
+  for (uint32_t p = 0; p < span; p++) {
+    finger(p, wheel, frames[p]);
+  }
+
+  uint32_t now = 0;
+  volatile uint16_t sink = 0;
+  uint64_t start = nanoseconds();
+#if defined(__x86_64__) || defined(__i386__)
+  uint64_t cycles = __rdtsc();
+#endif
+  for (uint32_t r = 0; r < ROUNDS; r++) {
+    for (uint32_t p = 0; p < span; p++) {
+      slider.update(frames[p], now++);
+      sink = sink + slider.position();
+    }
+  }
+  double updates = (double)ROUNDS * span;
+  printf("%-7s %6.1f ns/update", wheel ? "wheel" : "slider",
+         (nanoseconds() - start) / updates);
+#if defined(__x86_64__) || defined(__i386__)
+  printf(" %6.1f TSC cycles/update", (__rdtsc() - cycles) / updates);
+#endif
+  printf("\n");
+}
+
+int main() {
+  bool ok = sweep(false) && sweep(true);
+  if (ok) {
+    bench(false);
+    bench(true);
+  }
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}